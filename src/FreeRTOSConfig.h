@@ -74,7 +74,8 @@
 #define configUSE_TIME_SLICING                  0
 #define configUSE_NEWLIB_REENTRANT              0
 #define configENABLE_BACKWARD_COMPATIBILITY     0
-#define configUSE_TASK_NOTIFICATIONS            0
+/* Used by SpiNorFlash::Read() to wake the reading task. Adds 8 bytes to each TCB (about 60 bytes for all the tasks) */
+#define configUSE_TASK_NOTIFICATIONS            1
 
 /* Hook function related definitions. */
 #define configUSE_IDLE_HOOK            0
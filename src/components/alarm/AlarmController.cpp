@@ -19,13 +19,14 @@
 #include "systemtask/SystemTask.h"
 #include "task.h"
 #include <chrono>
+#include <cstring>
 #include <libraries/log/nrf_log.h>
 
 using namespace Pinetime::Controllers;
 using namespace std::chrono_literals;
 
 AlarmController::AlarmController(Controllers::DateTime& dateTimeController, Controllers::FS& fs)
-  : dateTimeController {dateTimeController}, fs {fs} {
+  : dateTimeController {dateTimeController}, fs {fs}, store {fs, "/.system/alarm"} {
 }
 
 namespace {
@@ -142,12 +143,29 @@ void AlarmController::SetRecurrence(RecurType recurrence) {
 }
 
 void AlarmController::LoadSettingsFromFile() {
+  AlarmSettings alarmBuffer;
+  if (store.GetAll(&alarmBuffer, sizeof(alarmBuffer)) && alarmBuffer.version == alarmFormatVersion) {
+    alarm = alarmBuffer;
+    std::memcpy(&persistedAlarm, &alarm, sizeof(alarm));
+    alarmPersisted = true;
+    NRF_LOG_INFO("[AlarmController] Loaded alarm settings");
+    return;
+  }
+
+  // Alarm saved by a previous firmware, move it to the store
+  if (LoadLegacySettingsFile()) {
+    SaveSettingsToFile();
+    fs.FileDelete("/.system/alarm.dat");
+  }
+}
+
+bool AlarmController::LoadLegacySettingsFile() {
   lfs_file_t alarmFile;
   AlarmSettings alarmBuffer;
 
   if (fs.FileOpen(&alarmFile, "/.system/alarm.dat", LFS_O_RDONLY) != LFS_ERR_OK) {
     NRF_LOG_WARNING("[AlarmController] Failed to open alarm data file");
-    return;
+    return false;
   }
 
   fs.FileRead(&alarmFile, reinterpret_cast<uint8_t*>(&alarmBuffer), sizeof(alarmBuffer));
@@ -156,26 +174,29 @@ void AlarmController::LoadSettingsFromFile() {
     NRF_LOG_WARNING("[AlarmController] Loaded alarm settings has version %u instead of %u, discarding",
                     alarmBuffer.version,
                     alarmFormatVersion);
-    return;
+    return false;
   }
 
   alarm = alarmBuffer;
   NRF_LOG_INFO("[AlarmController] Loaded alarm settings from file");
+  return true;
 }
 
-void AlarmController::SaveSettingsToFile() const {
-  lfs_dir systemDir;
-  if (fs.DirOpen("/.system", &systemDir) != LFS_ERR_OK) {
-    fs.DirCreate("/.system");
+void AlarmController::SaveSettingsToFile() {
+  static_assert(sizeof(AlarmSettings) <= KeyValueStore::maxSize);
+  bool saved;
+  if (alarmPersisted) {
+    saved = store.PutChanges(&alarm, &persistedAlarm, sizeof(alarm));
+  } else {
+    saved = store.PutAll(&alarm, sizeof(alarm));
+    if (saved) {
+      std::memcpy(&persistedAlarm, &alarm, sizeof(alarm));
+      alarmPersisted = true;
+    }
   }
-  fs.DirClose(&systemDir);
-  lfs_file_t alarmFile;
-  if (fs.FileOpen(&alarmFile, "/.system/alarm.dat", LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
-    NRF_LOG_WARNING("[AlarmController] Failed to open alarm data file for saving");
+  if (!saved) {
+    NRF_LOG_WARNING("[AlarmController] Failed to save alarm settings");
     return;
   }
-
-  fs.FileWrite(&alarmFile, reinterpret_cast<const uint8_t*>(&alarm), sizeof(alarm));
-  fs.FileClose(&alarmFile);
-  NRF_LOG_INFO("[AlarmController] Saved alarm settings with format version %u to file", alarm.version);
+  NRF_LOG_INFO("[AlarmController] Saved alarm settings with format version %u", alarm.version);
 }
@@ -21,6 +21,7 @@
 #include <timers.h>
 #include <cstdint>
 #include "components/datetime/DateTimeController.h"
+#include "components/fs/KeyValueStore.h"
 
 namespace Pinetime {
   namespace System {
@@ -82,13 +83,18 @@ namespace Pinetime {
 
       Controllers::DateTime& dateTimeController;
       Controllers::FS& fs;
+      KeyValueStore store;
       System::SystemTask* systemTask = nullptr;
       TimerHandle_t alarmTimer;
       AlarmSettings alarm;
+      // Copy of the alarm settings in the store, only the fields that differ from it are written
+      AlarmSettings persistedAlarm;
+      bool alarmPersisted = false;
       std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> alarmTime;
 
       void LoadSettingsFromFile();
-      void SaveSettingsToFile() const;
+      bool LoadLegacySettingsFile();
+      void SaveSettingsToFile();
     };
   }
 }
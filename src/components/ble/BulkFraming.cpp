@@ -0,0 +1,26 @@
+#include "components/ble/BulkFraming.h"
+#include <cstring>
+
+using namespace Pinetime::Controllers::BulkFraming;
+
+void Pinetime::Controllers::BulkFraming::WriteHeader(uint8_t* buffer, Services service, uint16_t length) {
+  FrameHeader header {service, 0, length};
+  std::memcpy(buffer, &header, sizeof(header));
+}
+
+FrameReader::FrameReader(uint8_t* sdu, uint16_t length) : sdu {sdu}, length {length} {
+}
+
+bool FrameReader::Next(FrameHeader& header, uint8_t*& payload) {
+  if (truncated || offset + sizeof(FrameHeader) > length) {
+    return false;
+  }
+  std::memcpy(&header, sdu + offset, sizeof(header));
+  if (header.length > length - offset - sizeof(FrameHeader)) {
+    truncated = true;
+    return false;
+  }
+  payload = sdu + offset + sizeof(FrameHeader);
+  offset += sizeof(FrameHeader) + header.length;
+  return true;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    // Frames of the L2CAP channel of BulkTransport (format in BulkTransport.h). This part doesn't depend on the BLE
+    // stack: tools/ble_bulk_framing.py --self-test builds it for the host and checks it against the Python framing.
+    namespace BulkFraming {
+      enum class Services : uint8_t { FS = 0x01, Dfu = 0x02 };
+
+      struct __attribute__((packed)) FrameHeader {
+        Services service;
+        uint8_t reserved;
+        uint16_t length;
+      };
+
+      // Writes the header of a frame of length bytes of payload, sizeof(FrameHeader) bytes
+      void WriteHeader(uint8_t* buffer, Services service, uint16_t length);
+
+      // Reads the frames of an SDU one by one
+      class FrameReader {
+      public:
+        FrameReader(uint8_t* sdu, uint16_t length);
+
+        // Returns false at the end of the SDU. A truncated frame ends the SDU: the frames that follow it can't be found
+        bool Next(FrameHeader& header, uint8_t*& payload);
+
+        bool IsTruncated() const {
+          return truncated;
+        }
+
+      private:
+        uint8_t* sdu;
+        uint16_t length;
+        uint16_t offset = 0;
+        bool truncated = false;
+      };
+    }
+  }
+}
@@ -0,0 +1,217 @@
+#include "components/ble/BulkTransport.h"
+#include <algorithm>
+#include <nrf_log.h>
+#include "components/ble/DfuService.h"
+#include "components/ble/FSService.h"
+#include "components/settings/Settings.h"
+#include "systemtask/SystemTask.h"
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_hs.h>
+#undef max
+#undef min
+
+using namespace Pinetime::Controllers;
+
+int BulkTransportCallback(ble_l2cap_event* event, void* arg) {
+  auto* bulkTransport = static_cast<BulkTransport*>(arg);
+  return bulkTransport->OnL2capEvent(event);
+}
+
+BulkTransport::BulkTransport(Pinetime::System::SystemTask& systemTask, FSService& fsService, DfuService& dfuService)
+  : systemTask {systemTask}, fsService {fsService}, dfuService {dfuService} {
+}
+
+void BulkTransport::Init() {
+  int res = ble_l2cap_create_server(psm, mtu, BulkTransportCallback, this);
+  ASSERT(res == 0);
+}
+
+int BulkTransport::OnL2capEvent(ble_l2cap_event* event) {
+  switch (event->type) {
+    case BLE_L2CAP_EVENT_COC_ACCEPT:
+      if (!IsAllowed()) {
+        NRF_LOG_INFO("[BULK] Channel refused, DFU and file access disabled in settings");
+        return BLE_HS_EAUTHOR;
+      }
+      if (channel != nullptr) {
+        return BLE_HS_ENOMEM;
+      }
+      NRF_LOG_INFO("[BULK] Channel accepted, peer MTU = %d", event->accept.peer_sdu_size);
+      channel = event->accept.chan;
+      connectionHandle = event->accept.conn_handle;
+      peerMtu = event->accept.peer_sdu_size;
+      stalled = false;
+      if (!PrepareReceive()) {
+        channel = nullptr;
+        return BLE_HS_ENOMEM;
+      }
+      return 0;
+
+    case BLE_L2CAP_EVENT_COC_CONNECTED:
+      NRF_LOG_INFO("[BULK] Channel connected, status = %d", event->connect.status);
+      if (event->connect.status != 0 && event->connect.chan == channel) {
+        Reset();
+      }
+      return 0;
+
+    case BLE_L2CAP_EVENT_COC_DISCONNECTED:
+      NRF_LOG_INFO("[BULK] Channel disconnected");
+      if (event->disconnect.chan == channel) {
+        Reset();
+      }
+      return 0;
+
+    case BLE_L2CAP_EVENT_COC_DATA_RECEIVED:
+      OnData(event->receive.sdu_rx);
+      return 0;
+
+    case BLE_L2CAP_EVENT_COC_TX_UNSTALLED:
+      if (event->tx_unstalled.status != 0) {
+        // The stalled SDU was dropped by the stack
+        NRF_LOG_INFO("[BULK] SDU not sent, status = %d", event->tx_unstalled.status);
+      }
+      stalled = false;
+      if (pending != nullptr) {
+        os_mbuf* sdu = pending;
+        pending = nullptr;
+        Transmit(sdu);
+      }
+      return 0;
+
+    default:
+      return 0;
+  }
+}
+
+int BulkTransport::Send(Services service, os_mbuf* om) {
+  if (channel == nullptr) {
+    os_mbuf_free_chain(om);
+    return BLE_HS_ENOTCONN;
+  }
+  if (OS_MBUF_PKTLEN(om) > MaxPayloadSize()) {
+    os_mbuf_free_chain(om);
+    return BLE_HS_EINVAL;
+  }
+
+  uint16_t length = OS_MBUF_PKTLEN(om);
+  // Frees om on failure
+  om = os_mbuf_prepend_pullup(om, sizeof(FrameHeader));
+  if (om == nullptr) {
+    return BLE_HS_ENOMEM;
+  }
+  BulkFraming::WriteHeader(om->om_data, service, length);
+
+  if (!stalled) {
+    return Transmit(om);
+  }
+  // The previous SDU waits for credits, the frame is sent in the next one
+  if (pending == nullptr) {
+    pending = om;
+    return 0;
+  }
+  if (OS_MBUF_PKTLEN(pending) + OS_MBUF_PKTLEN(om) > std::min(peerMtu, mtu)) {
+    os_mbuf_free_chain(om);
+    return BLE_HS_ENOMEM;
+  }
+  os_mbuf_concat(pending, om);
+  return 0;
+}
+
+bool BulkTransport::IsIdle() const {
+  return !stalled;
+}
+
+uint16_t BulkTransport::MaxPayloadSize() const {
+  if (channel == nullptr) {
+    return 0;
+  }
+  return std::min(peerMtu, mtu) - sizeof(FrameHeader);
+}
+
+void BulkTransport::Reset() {
+  // The channel itself is freed by the stack
+  channel = nullptr;
+  stalled = false;
+  if (pending != nullptr) {
+    os_mbuf_free_chain(pending);
+    pending = nullptr;
+  }
+}
+
+bool BulkTransport::IsAllowed() const {
+#ifndef PINETIME_IS_RECOVERY
+  return systemTask.GetSettings().GetDfuAndFsMode() != Pinetime::Controllers::Settings::DfuAndFsMode::Disabled;
+#else
+  return true;
+#endif
+}
+
+bool BulkTransport::PrepareReceive() {
+  // Grows as the SDU is received
+  os_mbuf* sdu = os_msys_get_pkthdr(0, 0);
+  if (sdu == nullptr) {
+    return false;
+  }
+  // The SDU belongs to the channel, even if this fails
+  return ble_l2cap_recv_ready(channel, sdu) == 0;
+}
+
+int BulkTransport::Transmit(os_mbuf* sdu) {
+  int res = ble_l2cap_send(channel, sdu);
+  if (res == BLE_HS_ESTALLED) {
+    // Queued by the stack, the rest of the SDU is sent as the peer gives credits (BLE_L2CAP_EVENT_COC_TX_UNSTALLED)
+    stalled = true;
+    return 0;
+  }
+  if (res == BLE_HS_EBUSY || res == BLE_HS_EBADDATA) {
+    // Only these errors leave the SDU to the caller
+    os_mbuf_free_chain(sdu);
+  }
+  if (res != 0) {
+    NRF_LOG_INFO("[BULK] Send failed, res = %d", res);
+  }
+  return res;
+}
+
+void BulkTransport::OnData(os_mbuf* sdu) {
+  // The stack doesn't accept SDUs larger than mtu
+  uint16_t length = OS_MBUF_PKTLEN(sdu);
+  os_mbuf_copydata(sdu, 0, length, rxBuffer);
+  os_mbuf_free_chain(sdu);
+
+  if (!IsAllowed()) {
+    // Disabled in the settings since the channel was opened
+    ble_l2cap_disconnect(channel);
+    return;
+  }
+
+  // Credits are given back before the frames are handled: the peer sends the next SDU meanwhile
+  bool ready = PrepareReceive();
+
+  BulkFraming::FrameReader reader {rxBuffer, length};
+  FrameHeader header;
+  uint8_t* payload;
+  while (reader.Next(header, payload)) {
+    switch (header.service) {
+      case Services::FS:
+        fsService.OnBulkCommand(connectionHandle, payload, header.length);
+        break;
+      case Services::Dfu:
+        dfuService.OnBulkData(connectionHandle, payload, header.length);
+        break;
+      default:
+        NRF_LOG_INFO("[BULK] Frame of unknown service %d", header.service);
+        break;
+    }
+  }
+  if (reader.IsTruncated()) {
+    NRF_LOG_INFO("[BULK] Truncated frame, length = %d", header.length);
+  }
+
+  if (!ready && channel != nullptr) {
+    // The peer has no credits left, it reconnects the channel or falls back to GATT
+    NRF_LOG_INFO("[BULK] No buffer for the next SDU, closing the channel");
+    ble_l2cap_disconnect(channel);
+  }
+}
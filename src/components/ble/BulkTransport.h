@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include "components/ble/BulkFraming.h"
+
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_l2cap.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace System {
+    class SystemTask;
+  }
+
+  namespace Controllers {
+    class DfuService;
+    class FSService;
+
+    // Bulk data of the FS and DFU services over an L2CAP connection-oriented channel (LE credit based flow control).
+    // The companion app opens the channel on the PSM below; the GATT characteristics stay available and are still
+    // used for the DFU control point.
+    //
+    // Each SDU carries one or more frames, a frame is never split between SDUs:
+    //
+    //   header   uint8 service, uint8 reserved (0), uint16 length of the payload. Little endian.
+    //   payload  FS: a command of the FS service, its responses are sent back on the channel.
+    //            DFU: data of the firmware image, in the Data state of the DFU service.
+    //
+    // The next SDU is accepted (credits are given back to the peer) as soon as the previous one is copied out of the
+    // BLE buffers, so the peer is paced by the channel instead of by notifications. tools/ble_bulk_framing.py
+    // implements the framing for the companion apps.
+    class BulkTransport {
+    public:
+      using Services = BulkFraming::Services;
+      using FrameHeader = BulkFraming::FrameHeader;
+
+      // First dynamic LE PSM
+      static constexpr uint16_t psm = 0x0080;
+      // Largest SDU accepted and sent
+      static constexpr uint16_t mtu = 512;
+
+      BulkTransport(Pinetime::System::SystemTask& systemTask, FSService& fsService, DfuService& dfuService);
+      void Init();
+      int OnL2capEvent(ble_l2cap_event* event);
+
+      // Sends a frame of the given service, om is always consumed. Frames sent while the channel waits for credits
+      // are queued in the same SDU, up to the MTU.
+      int Send(Services service, os_mbuf* om);
+      // Nothing waits for credits: the next frame is sent right away
+      bool IsIdle() const;
+      uint16_t MaxPayloadSize() const;
+      // Channel closed (disconnection)
+      void Reset();
+
+    private:
+      Pinetime::System::SystemTask& systemTask;
+      FSService& fsService;
+      DfuService& dfuService;
+
+      ble_l2cap_chan* channel = nullptr;
+      uint16_t connectionHandle = 0;
+      uint16_t peerMtu = 0;
+      bool stalled = false;
+      // Frames sent while stalled
+      os_mbuf* pending = nullptr;
+      // The received SDU is copied here, frames and commands are read from contiguous memory
+      uint8_t rxBuffer[mtu];
+
+      bool IsAllowed() const;
+      bool PrepareReceive();
+      int Transmit(os_mbuf* sdu);
+      void OnData(os_mbuf* sdu);
+    };
+  }
+}
@@ -1,5 +1,7 @@
 #include "components/ble/DfuService.h"
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 #include "components/ble/BleController.h"
 #include "components/ble/NotificationManager.h"
 #include "components/settings/Settings.h"
@@ -96,9 +98,13 @@ int DfuService::OnServiceData(uint16_t connectionHandle, uint16_t attributeHandl
     xTimerStart(timeoutTimer, 0);
   }
 
-  ble_gatts_find_chr(&serviceUuid.u, &packetCharacteristicUuid.u, nullptr, &packetCharacteristicHandle);
-  ble_gatts_find_chr(&serviceUuid.u, &controlPointCharacteristicUuid.u, nullptr, &controlPointCharacteristicHandle);
-  ble_gatts_find_chr(&serviceUuid.u, &revisionCharacteristicUuid.u, nullptr, &revisionCharacteristicHandle);
+  // The handles are assigned when the GATT server starts, after Init(). They don't change afterwards.
+  if (!handlesFound) {
+    ble_gatts_find_chr(&serviceUuid.u, &packetCharacteristicUuid.u, nullptr, &packetCharacteristicHandle);
+    ble_gatts_find_chr(&serviceUuid.u, &controlPointCharacteristicUuid.u, nullptr, &controlPointCharacteristicHandle);
+    ble_gatts_find_chr(&serviceUuid.u, &revisionCharacteristicUuid.u, nullptr, &revisionCharacteristicHandle);
+    handlesFound = true;
+  }
 
   if (attributeHandle == packetCharacteristicHandle) {
     if (context->op == BLE_GATT_ACCESS_OP_WRITE_CHR)
@@ -145,7 +151,7 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
         vTaskDelay(pdMS_TO_TICKS(5));
       }
 
-      dfuImage.Erase();
+      dfuImage.EraseTrailer();
 
       uint8_t data[] {16, 1, 1};
       notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, data, 3);
@@ -175,30 +181,8 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
       return 0;
     }
 
-    case States::Data: {
-      nbPacketReceived++;
-      dfuImage.Append(om->om_data, om->om_len);
-      bytesReceived += om->om_len;
-      bleController.FirmwareUpdateCurrentBytes(bytesReceived);
-
-      if ((nbPacketReceived % nbPacketsToNotify) == 0 && bytesReceived != applicationSize) {
-        uint8_t data[5] {static_cast<uint8_t>(Opcodes::PacketReceiptNotification),
-                         static_cast<uint8_t>(bytesReceived & 0x000000FFu),
-                         static_cast<uint8_t>(bytesReceived >> 8u),
-                         static_cast<uint8_t>(bytesReceived >> 16u),
-                         static_cast<uint8_t>(bytesReceived >> 24u)};
-        NRF_LOG_INFO("[DFU] -> Send packet notification: %d bytes received", bytesReceived);
-        notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, data, 5);
-      }
-      if (dfuImage.IsComplete()) {
-        uint8_t data[3] {static_cast<uint8_t>(Opcodes::Response),
-                         static_cast<uint8_t>(Opcodes::ReceiveFirmwareImage),
-                         static_cast<uint8_t>(ErrorCodes::NoError)};
-        NRF_LOG_INFO("[DFU] -> Send packet notification : all bytes received!");
-        notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, data, 3);
-        state = States::Validate;
-      }
-    }
+    case States::Data:
+      ReceiveImageData(connectionHandle, om->om_data, om->om_len, true);
       return 0;
     default:
       // Invalid state
@@ -207,6 +191,43 @@ int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
   return 0;
 }
 
+void DfuService::OnBulkData(uint16_t connectionHandle, uint8_t* data, size_t size) {
+  if (state != States::Data) {
+    NRF_LOG_INFO("[DFU] -> Image data received on the L2CAP channel, but we are not in Data state");
+    return;
+  }
+  xTimerStart(timeoutTimer, 0);
+  // Data past the end of the image is ignored
+  size = std::min<size_t>(size, applicationSize - bytesReceived);
+  // The peer is paced by the credits of the channel, not by packet receipt notifications
+  ReceiveImageData(connectionHandle, data, size, false);
+}
+
+void DfuService::ReceiveImageData(uint16_t connectionHandle, uint8_t* data, size_t size, bool receiptNotifications) {
+  nbPacketReceived++;
+  dfuImage.Append(data, size);
+  bytesReceived += size;
+  bleController.FirmwareUpdateCurrentBytes(bytesReceived);
+
+  if (receiptNotifications && (nbPacketReceived % nbPacketsToNotify) == 0 && bytesReceived != applicationSize) {
+    uint8_t notification[5] {static_cast<uint8_t>(Opcodes::PacketReceiptNotification),
+                             static_cast<uint8_t>(bytesReceived & 0x000000FFu),
+                             static_cast<uint8_t>(bytesReceived >> 8u),
+                             static_cast<uint8_t>(bytesReceived >> 16u),
+                             static_cast<uint8_t>(bytesReceived >> 24u)};
+    NRF_LOG_INFO("[DFU] -> Send packet notification: %d bytes received", bytesReceived);
+    notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, notification, 5);
+  }
+  if (dfuImage.IsComplete()) {
+    uint8_t response[3] {static_cast<uint8_t>(Opcodes::Response),
+                         static_cast<uint8_t>(Opcodes::ReceiveFirmwareImage),
+                         static_cast<uint8_t>(ErrorCodes::NoError)};
+    NRF_LOG_INFO("[DFU] -> Send packet notification : all bytes received!");
+    notificationManager.Send(connectionHandle, controlPointCharacteristicHandle, response, 3);
+    state = States::Validate;
+  }
+}
+
 int DfuService::ControlPointHandler(uint16_t connectionHandle, os_mbuf* om) {
   auto opcode = static_cast<Opcodes>(om->om_data[0]);
   NRF_LOG_INFO("[DFU] -> ControlPointHandler");
@@ -373,29 +394,178 @@ void DfuService::DfuImage::Init(size_t chunkSize, size_t totalSize, uint16_t exp
   this->totalSize = totalSize;
   this->expectedCrc = expectedCrc;
   this->ready = true;
+  imageSize = totalSize;
+  receivedSize = 0;
   totalWriteIndex = 0;
   bufferWriteIndex = 0;
+  crc = 0xFFFF;
+  writeFailed = false;
+  if (spiNorFlash.LastWriteFailed()) {
+    // A write of the previous transfer failed after it ended: the state of the slot is not known
+    blankSectors.reset();
+    writtenSectors.set();
+    spiNorFlash.ResetWriteFailure();
+  }
+  invalidData = false;
+  readySectors = 0;
+  compressed = false;
+  imageCrc = 0xFFFF;
+  decoder.Reset();
 }
 
 void DfuService::DfuImage::Append(uint8_t* data, size_t size) {
   if (!ready)
     return;
-  ASSERT(size <= 20);
 
-  std::memcpy(tempBuffer + bufferWriteIndex, data, size);
-  bufferWriteIndex += size;
+  // The CRC is computed as the data arrives, the image doesn't need to be read back to be validated
+  crc = ComputeCrc(data, size, &crc);
+
+  if (receivedSize == 0 && size >= sizeof(CompressedHeader)) {
+    CompressedHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    // Never the first bytes of an MCUBoot image
+    if (header.magic == compressedMagic) {
+      compressed = true;
+      imageSize = header.size;
+      expectedImageCrc = header.crc;
+      if (header.version != compressedVersion || header.windowBits > Utility::LzssDecoder::windowBits || imageSize > maxSize) {
+        invalidData = true;
+      }
+      receivedSize += sizeof(header);
+      data += sizeof(header);
+      size -= sizeof(header);
+    }
+  }
+  receivedSize += size;
+
+  if (compressed) {
+    Decompress(data, size);
+  } else {
+    Copy(data, size);
+  }
+
+  if (IsComplete()) {
+    WaitForFlash();
+    if (imageSize < maxSize && IsImageValid())
+      WriteMagicNumber();
+  } else {
+    EraseAhead();
+  }
+}
+
+void DfuService::DfuImage::Copy(const uint8_t* data, size_t size) {
+  while (size > 0) {
+    size_t length = std::min(size, bufferSize - bufferWriteIndex);
+    std::memcpy(window + (totalWriteIndex % windowSize) + bufferWriteIndex, data, length);
+    bufferWriteIndex += length;
+    data += length;
+    size -= length;
+
+    if (bufferWriteIndex == bufferSize || totalWriteIndex + bufferWriteIndex == imageSize) {
+      ProgramBuffer();
+    }
+  }
+}
+
+void DfuService::DfuImage::Decompress(const uint8_t* data, size_t size) {
+  if (!invalidData && !decoder.Decode(data, size)) {
+    invalidData = true;
+  }
+}
+
+bool DfuService::DfuImage::OnDecodedByte(void* context, uint8_t value) {
+  auto* image = static_cast<DfuImage*>(context);
+  image->Output(value);
+  return !image->invalidData;
+}
 
-  if (bufferWriteIndex == bufferSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
+void DfuService::DfuImage::Output(uint8_t value) {
+  if (totalWriteIndex + bufferWriteIndex == imageSize) {
+    invalidData = true;
+    return;
+  }
+  window[(totalWriteIndex + bufferWriteIndex) % windowSize] = value;
+  bufferWriteIndex++;
+  if (bufferWriteIndex == bufferSize || totalWriteIndex + bufferWriteIndex == imageSize) {
+    ProgramBuffer();
+  }
+}
+
+void DfuService::DfuImage::ProgramBuffer() {
+  size_t sector = totalWriteIndex / sectorSize;
+  if (sector >= nbSectors) {
+    // The image is larger than the slot
+    invalidData = true;
     totalWriteIndex += bufferWriteIndex;
     bufferWriteIndex = 0;
+    return;
   }
 
-  if (bufferWriteIndex > 0 && totalWriteIndex + bufferWriteIndex == totalSize) {
-    spiNorFlash.Write(writeOffset + totalWriteIndex, tempBuffer, bufferWriteIndex);
-    totalWriteIndex += bufferWriteIndex;
-    if (totalSize < maxSize)
-      WriteMagicNumber();
+  // Usually already erased ahead of the data
+  while (readySectors <= sector) {
+    WaitForFlash();
+    PrepareSector(readySectors++);
+  }
+
+  // The buffer is page aligned: the flash programs it while the next packets are received
+  const uint8_t* page = window + (totalWriteIndex % windowSize);
+  WaitForFlash();
+  spiNorFlash.ProgramPageAsync(writeOffset + totalWriteIndex, page, bufferWriteIndex);
+  blankSectors[sector] = false;
+  writtenSectors[sector] = true;
+  if (compressed) {
+    imageCrc = ComputeCrc(page, bufferWriteIndex, &imageCrc);
+  }
+  totalWriteIndex += bufferWriteIndex;
+  bufferWriteIndex = 0;
+}
+
+void DfuService::DfuImage::EraseAhead() {
+  // Keeps the sector that follows the one being written erased. The erase is only started when the flash is idle,
+  // it runs while the packets of the current page are received.
+  size_t imageSectors = std::min((imageSize + sectorSize - 1) / sectorSize, nbSectors);
+  size_t targetSectors = std::min(totalWriteIndex / sectorSize + 2, imageSectors);
+  while (readySectors < targetSectors) {
+    if (!blankSectors[readySectors] && spiNorFlash.IsBusy()) {
+      return;
+    }
+    WaitForFlash();
+    PrepareSector(readySectors++);
+  }
+}
+
+void DfuService::DfuImage::PrepareSector(size_t sector) {
+  if (!blankSectors[sector] && (writtenSectors[sector] || !IsBlank(sector))) {
+    // The next access to the flash waits for the end of the erase
+    spiNorFlash.SectorEraseAsync(writeOffset + sector * sectorSize);
+    writtenSectors[sector] = false;
+  }
+  blankSectors[sector] = true;
+}
+
+bool DfuService::DfuImage::IsBlank(size_t sector) {
+  // Reading a sector is about 10 times faster than erasing it, and a sector that holds data usually fails on its first bytes
+  uint8_t buffer[128];
+  for (size_t offset = 0; offset < sectorSize; offset += sizeof(buffer)) {
+    spiNorFlash.Read(writeOffset + sector * sectorSize + offset, buffer, sizeof(buffer));
+    if (std::any_of(std::begin(buffer), std::end(buffer), [](uint8_t b) {
+          return b != 0xFF;
+        })) {
+      writtenSectors[sector] = true;
+      return false;
+    }
+  }
+  return true;
+}
+
+void DfuService::DfuImage::WaitForFlash() {
+  // The pages and sectors of the image can also be completed by reads of other tasks (fonts, images, files)
+  spiNorFlash.WaitForPendingWrite();
+  if (spiNorFlash.LastWriteFailed() && !writeFailed) {
+    writeFailed = true;
+    // The state of the slot is not known anymore
+    blankSectors.reset();
+    writtenSectors.set();
   }
 }
 
@@ -410,33 +580,24 @@ void DfuService::DfuImage::WriteMagicNumber() {
 
   uint32_t offset = writeOffset + (maxSize - (4 * sizeof(uint32_t)));
   spiNorFlash.Write(offset, reinterpret_cast<const uint8_t*>(magic), 4 * sizeof(uint32_t));
+  blankSectors[nbSectors - 1] = false;
+  writtenSectors[nbSectors - 1] = true;
 }
 
-void DfuService::DfuImage::Erase() {
-  for (size_t erased = 0; erased < maxSize; erased += 0x1000) {
-    spiNorFlash.SectorErase(writeOffset + erased);
-  }
+void DfuService::DfuImage::EraseTrailer() {
+  WaitForFlash();
+  PrepareSector(nbSectors - 1);
 }
 
 bool DfuService::DfuImage::Validate() {
-  uint32_t chunkSize = 200;
-  size_t currentOffset = 0;
-  uint16_t crc = 0;
-
-  bool first = true;
-  while (currentOffset < totalSize) {
-    uint32_t readSize = (totalSize - currentOffset) > chunkSize ? chunkSize : (totalSize - currentOffset);
-
-    spiNorFlash.Read(writeOffset + currentOffset, tempBuffer, readSize);
-    if (first) {
-      crc = ComputeCrc(tempBuffer, readSize, NULL);
-      first = false;
-    } else
-      crc = ComputeCrc(tempBuffer, readSize, &crc);
-    currentOffset += readSize;
-  }
+  // The flash reports programming failures, so what was received is what was written
+  WaitForFlash();
+  return !writeFailed && IsImageValid() && (crc == expectedCrc);
+}
 
-  return (crc == expectedCrc);
+bool DfuService::DfuImage::IsImageValid() const {
+  // The CRC of the init packet only covers the compressed data
+  return !invalidData && totalWriteIndex == imageSize && (!compressed || imageCrc == expectedImageCrc);
 }
 
 uint16_t DfuService::DfuImage::ComputeCrc(uint8_t const* p_data, uint32_t size, uint16_t const* p_crc) {
@@ -456,5 +617,5 @@ uint16_t DfuService::DfuImage::ComputeCrc(uint8_t const* p_data, uint32_t size,
 bool DfuService::DfuImage::IsComplete() {
   if (!ready)
     return false;
-  return totalWriteIndex == totalSize;
+  return receivedSize == totalSize;
 }
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <array>
+#include <bitset>
+#include "utility/Lzss.h"
 
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
@@ -30,6 +32,8 @@ namespace Pinetime {
                  Pinetime::Drivers::SpiNorFlash& spiNorFlash);
       void Init();
       int OnServiceData(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+      // Image data received on the L2CAP channel instead of the packet characteristic
+      void OnBulkData(uint16_t connectionHandle, uint8_t* data, size_t size);
       void OnTimeout();
       void Reset();
 
@@ -53,28 +57,80 @@ namespace Pinetime {
 
       class DfuImage {
       public:
-        DfuImage(Pinetime::Drivers::SpiNorFlash& spiNorFlash) : spiNorFlash {spiNorFlash} {
+        DfuImage(Pinetime::Drivers::SpiNorFlash& spiNorFlash) : spiNorFlash {spiNorFlash}, decoder {window, OnDecodedByte, this} {
         }
 
         void Init(size_t chunkSize, size_t totalSize, uint16_t expectedCrc);
-        void Erase();
+        // Starts erasing the end of the slot, where the bootloader looks for the magic number, so that an interrupted
+        // transfer can't leave an image that looks valid. The rest of the slot is erased while the image is received.
+        void EraseTrailer();
         void Append(uint8_t* data, size_t size);
         bool Validate();
         bool IsComplete();
 
       private:
         Pinetime::Drivers::SpiNorFlash& spiNorFlash;
-        static constexpr size_t bufferSize = 200;
+        // One flash page: it is programmed while the next one is received
+        static constexpr size_t bufferSize = 256;
+        // Images can be sent compressed (see tools/dfu_compress.py): LZSS with a 1 KB window, decompressed as they are
+        // received. The header is at the start of the image, the CRC of the init packet covers the compressed data.
+        static constexpr uint32_t compressedMagic = 0x5A4C5449; // "ITLZ"
+        static constexpr uint8_t compressedVersion = 1;
+        static constexpr size_t windowSize = Utility::LzssDecoder::windowSize;
+
+        struct __attribute__((packed)) CompressedHeader {
+          uint32_t magic;
+          // Size and CRC of the decompressed image
+          uint32_t size;
+          uint16_t crc;
+          uint8_t version;
+          uint8_t windowBits;
+        };
+
         bool ready = false;
         size_t chunkSize = 0;
+        // Size of the data sent by the companion app, and of the image written to the slot (different if compressed)
         size_t totalSize = 0;
-        size_t maxSize = 475136;
+        size_t imageSize = 0;
+        static constexpr size_t maxSize = 475136;
+        static constexpr size_t sectorSize = 0x1000;
+        static constexpr size_t nbSectors = maxSize / sectorSize;
+        size_t receivedSize = 0;
         size_t bufferWriteIndex = 0;
         size_t totalWriteIndex = 0;
         static constexpr size_t writeOffset = 0x40000;
-        uint8_t tempBuffer[bufferSize];
+        // Last bytes of the image: the page being received, and the history that compressed data refers to
+        uint8_t window[windowSize];
         uint16_t expectedCrc = 0;
-
+        // CRC of the data received so far
+        uint16_t crc = 0;
+        // A program or an erase failed
+        bool writeFailed = false;
+        // The compressed data is corrupted, or the image doesn't fit in the slot
+        bool invalidData = false;
+
+        bool compressed = false;
+        uint16_t expectedImageCrc = 0;
+        uint16_t imageCrc = 0;
+        Utility::LzssDecoder decoder;
+
+        // Sectors of the slot known to be erased, since the last erase or blank check, and sectors known to hold data.
+        // This is kept across transfers: a slot left clean by an interrupted transfer is not erased again.
+        std::bitset<nbSectors> blankSectors;
+        std::bitset<nbSectors> writtenSectors;
+        // Number of sectors, from the start of the slot, that were erased (or found blank) for this transfer
+        size_t readySectors = 0;
+
+        void Copy(const uint8_t* data, size_t size);
+        void Decompress(const uint8_t* data, size_t size);
+        void Output(uint8_t value);
+        static bool OnDecodedByte(void* context, uint8_t value);
+        bool IsImageValid() const;
+        void ProgramBuffer();
+        void EraseAhead();
+        void PrepareSector(size_t sector);
+        bool IsBlank(size_t sector);
+        void WaitForFlash();
         void WriteMagicNumber();
         uint16_t ComputeCrc(uint8_t const* p_data, uint32_t size, uint16_t const* p_crc);
       };
@@ -116,6 +172,7 @@ namespace Pinetime {
       uint16_t packetCharacteristicHandle;
       uint16_t controlPointCharacteristicHandle;
       uint16_t revisionCharacteristicHandle;
+      bool handlesFound = false;
 
       enum class States : uint8_t { Idle, Init, Start, Data, Validate, Validated };
       States state = States::Idle;
@@ -159,6 +216,7 @@ namespace Pinetime {
 
       int SendDfuRevision(os_mbuf* om) const;
       int WritePacketHandler(uint16_t connectionHandle, os_mbuf* om);
+      void ReceiveImageData(uint16_t connectionHandle, uint8_t* data, size_t size, bool receiptNotifications);
       int ControlPointHandler(uint16_t connectionHandle, os_mbuf* om);
 
       TimerHandle_t timeoutTimer;
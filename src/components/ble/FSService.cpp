@@ -1,9 +1,17 @@
 #include <nrf_log.h>
+#include <algorithm>
 #include "FSService.h"
 #include "components/ble/BleController.h"
+#include "components/ble/BulkTransport.h"
 #include "components/ble/NotificationManager.h"
 #include "components/settings/Settings.h"
 #include "systemtask/SystemTask.h"
+#include "utility/Crc32.h"
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <nimble/nimble_port.h>
+#undef max
+#undef min
 
 using namespace Pinetime::Controllers;
 
@@ -16,9 +24,20 @@ int FSServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gat
   return fsService->OnFSServiceRequested(conn_handle, attr_handle, ctxt);
 }
 
-FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs)
+void SessionTimeoutCallback(ble_npl_event* event) {
+  auto* fsService = static_cast<FSService*>(ble_npl_event_get_arg(event));
+  fsService->OnSessionTimeout();
+}
+
+void ListDirRetryCallback(ble_npl_event* event) {
+  auto* fsService = static_cast<FSService*>(ble_npl_event_get_arg(event));
+  fsService->OnListDirRetry();
+}
+
+FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs, BulkTransport& bulkTransport)
   : systemTask {systemTask},
     fs {fs},
+    bulkTransport {bulkTransport},
     characteristicDefinition {{.uuid = &fsVersionUuid.u,
                                .access_cb = FSServiceCallback,
                                .arg = this,
@@ -48,6 +67,10 @@ void FSService::Init() {
 
   res = ble_gatts_add_svcs(serviceDefinition);
   ASSERT(res == 0);
+
+  // Run in the host task, like the commands: they use the file or the directory of the command in progress
+  ble_npl_callout_init(&listRetryCallout, nimble_port_get_dflt_eventq(), ListDirRetryCallback, this);
+  ble_npl_callout_init(&sessionCallout, nimble_port_get_dflt_eventq(), SessionTimeoutCallback, this);
 }
 
 int FSService::OnFSServiceRequested(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
@@ -69,13 +92,22 @@ int FSService::OnFSServiceRequested(uint16_t connectionHandle, uint16_t attribut
     return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
   }
   if (attributeHandle == transferCharacteristicHandle) {
-    return FSCommandHandler(connectionHandle, context->om);
+    overBulkTransport = false;
+    return FSCommandHandler(connectionHandle, context->om->om_data, context->om->om_len);
   }
   return 0;
 }
 
-int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
-  auto command = static_cast<commands>(om->om_data[0]);
+void FSService::OnBulkCommand(uint16_t connectionHandle, uint8_t* data, uint16_t size) {
+  if (size == 0) {
+    return;
+  }
+  overBulkTransport = true;
+  FSCommandHandler(connectionHandle, data, size);
+}
+
+int FSService::FSCommandHandler(uint16_t connectionHandle, uint8_t* data, uint16_t size) {
+  auto command = static_cast<commands>(data[0]);
   NRF_LOG_INFO("[FS_S] -> FSCommandHandler Command %d", command);
   // Just always make sure we are awake...
   systemTask.PushMessage(Pinetime::System::Messages::StartFileTransfer);
@@ -83,80 +115,45 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
   while (systemTask.IsSleeping()) {
     vTaskDelay(100); // 50ms
   }
-  lfs_dir_t dir = {0};
+  if (command != commands::READ_PACING && command != commands::WRITE_DATA) {
+    CloseSession();
+  }
+  CloseListing();
   lfs_info info = {0};
-  lfs_file f = {0};
   switch (command) {
     case commands::READ: {
       NRF_LOG_INFO("[FS_S] -> Read");
-      auto* header = (ReadHeader*) om->om_data;
+      auto* header = (ReadHeader*) data;
       uint16_t plen = header->pathlen;
       if (plen > maxpathlen) { //> counts for null term
         return -1;
       }
       memcpy(filepath, header->pathstr, plen);
       filepath[plen] = 0; // Copy and null terminate string
-      ReadResponse resp;
-      os_mbuf* om;
-      resp.command = commands::READ_DATA;
-      resp.status = 0x01;
-      resp.chunkoff = header->chunkoff;
-      int res = fs.Stat(filepath, &info);
-      if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
+      int res = OpenSession(FSState::READ, LFS_O_RDONLY, header->chunkoff);
+      if (res < 0) {
+        ReadResponse resp;
+        resp.command = commands::READ_DATA;
         resp.status = (int8_t) res;
+        resp.chunkoff = header->chunkoff;
         resp.chunklen = 0;
         resp.totallen = 0;
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-      } else {
-        resp.chunklen = std::min(header->chunksize, info.size); // TODO add mtu somehow
-        resp.totallen = info.size;
-        fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-        fs.FileSeek(&f, header->chunkoff);
-        uint8_t fileData[resp.chunklen] = {0};
-        resp.chunklen = fs.FileRead(&f, fileData, resp.chunklen);
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-        os_mbuf_append(om, fileData, resp.chunklen);
-        fs.FileClose(&f);
+        auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+        Respond(connectionHandle, om);
+        break;
       }
-
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      SendReadData(connectionHandle, header->chunkoff, header->chunksize);
       break;
     }
     case commands::READ_PACING: {
       NRF_LOG_INFO("[FS_S] -> Readpacing");
-      auto* header = (ReadHeader*) om->om_data;
-      ReadResponse resp;
-      resp.command = commands::READ_DATA;
-      resp.status = 0x01;
-      resp.chunkoff = header->chunkoff;
-      int res = fs.Stat(filepath, &info);
-      if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-        resp.status = (int8_t) res;
-        resp.chunklen = 0;
-        resp.totallen = 0;
-      } else {
-        resp.chunklen = std::min(header->chunksize, info.size); // TODO add mtu somehow
-        resp.totallen = info.size;
-        fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-        fs.FileSeek(&f, header->chunkoff);
-      }
-      os_mbuf* om;
-      if (resp.chunklen > 0) {
-        uint8_t fileData[resp.chunklen] = {0};
-        resp.chunklen = fs.FileRead(&f, fileData, resp.chunklen);
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-        os_mbuf_append(om, fileData, resp.chunklen);
-      } else {
-        resp.chunklen = 0;
-        om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
-      }
-      fs.FileClose(&f);
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      auto* header = (ReadPacing*) data;
+      SendReadData(connectionHandle, header->chunkoff, header->chunksize);
       break;
     }
     case commands::WRITE: {
       NRF_LOG_INFO("[FS_S] -> Write");
-      auto* header = (WriteHeader*) om->om_data;
+      auto* header = (WriteHeader*) data;
       uint16_t plen = header->pathlen;
       if (plen > maxpathlen) { //> counts for null term
         return -1;             // TODO make this actually return a BLE notif
@@ -169,41 +166,57 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       resp.offset = header->offset;
       resp.modTime = 0;
 
-      int res = fs.FileOpen(&f, filepath, LFS_O_RDWR | LFS_O_CREAT);
-      if (res == 0) {
-        fs.FileClose(&f);
-        resp.status = (res == 0) ? 0x01 : (int8_t) res;
+      int res = OpenSession(FSState::WRITE, LFS_O_RDWR | LFS_O_CREAT, header->offset);
+      writeCrc = 0;
+      writeFromStart = (header->offset == 0);
+      if (res >= 0 && cursor >= static_cast<uint32_t>(fileSize)) {
+        // Nothing to write
+        res = CloseSession();
       }
+      resp.status = (res >= 0) ? 0x01 : (int8_t) res;
       resp.freespace = std::min(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - header->offset);
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      Respond(connectionHandle, om);
       break;
     }
     case commands::WRITE_DATA: {
       NRF_LOG_INFO("[FS_S] -> WriteData");
-      auto* header = (WritePacing*) om->om_data;
+      auto* header = (WritePacing*) data;
       WriteResponse resp;
       resp.command = commands::WRITE_PACING;
       resp.offset = header->offset;
-      int res = 0;
+      resp.modTime = 0;
+      int res = LFS_ERR_INVAL;
 
-      if (!(res = fs.FileOpen(&f, filepath, LFS_O_RDWR | LFS_O_CREAT))) {
-        if ((res = fs.FileSeek(&f, header->offset)) >= 0) {
-          res = fs.FileWrite(&f, header->data, header->dataSize);
-        }
-        fs.FileClose(&f);
+      if (state == FSState::WRITE && header->offset == cursor) {
+        res = fs.FileWrite(&file, header->data, header->dataSize);
       }
-      if (res < 0) {
-        resp.status = (int8_t) res;
+      if (res >= 0) {
+        cursor += res;
+        writeCrc = Pinetime::Utility::Crc32(header->data, res, writeCrc);
+        if (cursor >= static_cast<uint32_t>(fileSize)) {
+          // The data is committed when the file is closed. The file can be longer than what was written if it existed.
+          bool hashed = writeFromStart && fs.FileSize(&file) == static_cast<int>(cursor);
+          res = CloseSession();
+          if (res >= 0 && hashed) {
+            // Saves reading the file again when its hash is queried
+            fs.SetContentHash(filepath, {writeCrc, cursor});
+          }
+        } else {
+          ble_npl_callout_reset(&sessionCallout, sessionTimeout);
+        }
+      } else {
+        CloseSession();
       }
+      resp.status = (res >= 0) ? 0x01 : (int8_t) res;
       resp.freespace = std::min(fs.getSize() - (fs.GetFSSize() * fs.getBlockSize()), fileSize - header->offset);
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(WriteResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      Respond(connectionHandle, om);
       break;
     }
     case commands::DELETE: {
       NRF_LOG_INFO("[FS_S] -> Delete");
-      auto* header = (DelHeader*) om->om_data;
+      auto* header = (DelHeader*) data;
       uint16_t plen = header->pathlen;
       char path[plen + 1] = {0};
       memcpy(path, header->pathstr, plen);
@@ -213,12 +226,12 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       int res = fs.FileDelete(path);
       resp.status = (res == 0) ? 0x01 : (int8_t) res;
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(DelResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      Respond(connectionHandle, om);
       break;
     }
     case commands::MKDIR: {
       NRF_LOG_INFO("[FS_S] -> MKDir");
-      auto* header = (MKDirHeader*) om->om_data;
+      auto* header = (MKDirHeader*) data;
       uint16_t plen = header->pathlen;
       char path[plen + 1] = {0};
       memcpy(path, header->pathstr, plen);
@@ -229,76 +242,45 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       int res = fs.DirCreate(path);
       resp.status = (res == 0) ? 0x01 : (int8_t) res;
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(MKDirResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      Respond(connectionHandle, om);
       break;
     }
     case commands::LISTDIR: {
       NRF_LOG_INFO("[FS_S] -> ListDir");
-      ListDirHeader* header = (ListDirHeader*) om->om_data;
+      ListDirHeader* header = (ListDirHeader*) data;
       uint16_t plen = header->pathlen;
       char path[plen + 1] = {0};
       path[plen] = 0; // Copy and null terminate string
       memcpy(path, header->pathstr, plen);
 
-      ListDirResponse resp {};
-
-      resp.command = commands::LISTDIR_ENTRY;
-      resp.status = 0x01;
-      resp.totalentries = 0;
-      resp.entry = 0;
-      resp.modification_time = 0;
-      int res = fs.DirOpen(path, &dir);
+      int res = fs.DirOpen(path, &listDir);
       if (res != 0) {
+        ListDirResponse resp {};
+        resp.command = commands::LISTDIR_ENTRY;
         resp.status = (int8_t) res;
         auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ListDirResponse));
-        ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+        Respond(connectionHandle, om);
         break;
       };
-      while (fs.DirRead(&dir, &info)) {
-        resp.totalentries++;
+      // Each entry carries the number of entries: they are counted before the first one is sent
+      listTotalEntries = 0;
+      while (fs.DirRead(&listDir, &info) > 0) {
+        listTotalEntries++;
       }
-      fs.DirRewind(&dir);
-      while (true) {
-        res = fs.DirRead(&dir, &info);
-        if (res <= 0) {
-          break;
-        }
-        switch (info.type) {
-          case LFS_TYPE_REG: {
-            resp.flags = 0;
-            resp.file_size = info.size;
-            break;
-          }
-          case LFS_TYPE_DIR: {
-            resp.flags = 1;
-            resp.file_size = 0;
-            break;
-          }
-        }
+      fs.DirRewind(&listDir);
 
-        // strcpy(resp.path, info.name);
-        resp.path_length = strlen(info.name);
-        auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ListDirResponse));
-        os_mbuf_append(om, info.name, resp.path_length);
-        ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
-        /*
-         * Todo Figure out how to know when the previous Notify was TX'd
-         * For now just delay 100ms to make sure that the data went out...
-         */
-        vTaskDelay(100); // Allow stuff to actually go out over the BLE conn
-        resp.entry++;
-      }
-      assert(fs.DirClose(&dir) == 0);
-      resp.file_size = 0;
-      resp.path_length = 0;
-      resp.flags = 0;
-      auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ListDirResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      listing = true;
+      listConnectionHandle = connectionHandle;
+      listPacked = overBulkTransport;
+      hasListEntry = false;
+      listEnded = false;
+      listNextEntry = 0;
+      ContinueListing();
       break;
     }
     case commands::MOVE: {
       NRF_LOG_INFO("[FS_S] -> Move");
-      MoveHeader* header = (MoveHeader*) om->om_data;
+      MoveHeader* header = (MoveHeader*) data;
       uint16_t plen = header->OldPathLength;
       // Null Terminate string
       header->pathstr[plen] = 0;
@@ -310,7 +292,13 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
       int8_t res = (int8_t) fs.Rename(header->pathstr, path);
       resp.status = (res == 0) ? 1 : res;
       auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(MoveResponse));
-      ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+      Respond(connectionHandle, om);
+      break;
+    }
+    case commands::HASH: {
+      NRF_LOG_INFO("[FS_S] -> Hash");
+      SendHashes(connectionHandle, data, size);
+      break;
     }
     default:
       break;
@@ -320,25 +308,242 @@ int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
   return 0;
 }
 
-// Loads resp with file data given a valid filepath header and resp
-void FSService::prepareReadDataResp(ReadHeader* header, ReadResponse* resp) {
-  // uint16_t plen = header->pathlen;
-  resp->command = commands::READ_DATA;
-  resp->chunkoff = header->chunkoff;
-  resp->status = 0x01;
-  struct lfs_info info = {};
-  int res = fs.Stat(filepath, &info);
-  if (res == LFS_ERR_NOENT && info.type != LFS_TYPE_DIR) {
-    resp->status = 0x03;
-    resp->chunklen = 0;
-    resp->totallen = 0;
+int FSService::OpenSession(FSState newState, int flags, uint32_t offset) {
+  int res = fs.FileOpen(&file, filepath, flags);
+  if (res < 0) {
+    return res;
+  }
+  state = newState;
+  if (newState == FSState::READ) {
+    fileSize = fs.FileSize(&file);
+    if (fileSize < 0 || offset > static_cast<uint32_t>(fileSize)) {
+      res = (fileSize < 0) ? fileSize : LFS_ERR_INVAL;
+      CloseSession();
+      return res;
+    }
+  }
+  if (offset > 0 && (res = fs.FileSeek(&file, offset)) < 0) {
+    CloseSession();
+    return res;
+  }
+  cursor = offset;
+  ble_npl_callout_reset(&sessionCallout, sessionTimeout);
+  return 0;
+}
+
+int FSService::CloseSession() {
+  if (state == FSState::IDLE) {
+    return 0;
+  }
+  ble_npl_callout_stop(&sessionCallout);
+  state = FSState::IDLE;
+  return fs.FileClose(&file);
+}
+
+void FSService::SendReadData(uint16_t connectionHandle, uint32_t offset, uint32_t chunkSize) {
+  ReadResponse resp;
+  resp.command = commands::READ_DATA;
+  resp.status = 0x01;
+  resp.chunkoff = offset;
+  resp.totallen = (state == FSState::READ) ? fileSize : 0;
+  resp.chunklen = 0;
+  if (state != FSState::READ || offset != cursor) {
+    resp.status = (int8_t) LFS_ERR_INVAL;
+    CloseSession();
+    auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+    Respond(connectionHandle, om);
+    return;
+  }
+
+  // The chunk is shortened to fit in one notification (or one frame)
+  uint16_t maxSize = MaxResponseSize(connectionHandle);
+  uint32_t room = (maxSize > sizeof(ReadResponse)) ? maxSize - sizeof(ReadResponse) : 0;
+  uint32_t length = std::min<uint32_t>({chunkSize, fileSize - cursor, room});
+  uint8_t fileData[length + 1];
+  int res = fs.FileRead(&file, fileData, length);
+  if (res < 0) {
+    resp.status = (int8_t) res;
+  } else {
+    resp.chunklen = res;
+    cursor += res;
+  }
+  auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(ReadResponse));
+  os_mbuf_append(om, fileData, resp.chunklen);
+  Respond(connectionHandle, om);
+
+  if (res <= 0 || cursor >= static_cast<uint32_t>(fileSize)) {
+    CloseSession();
+  } else {
+    ble_npl_callout_reset(&sessionCallout, sessionTimeout);
+  }
+}
+
+void FSService::SendHashes(uint16_t connectionHandle, const uint8_t* data, uint16_t size) {
+  HashResponse resp {};
+  resp.command = commands::HASH_STATUS;
+  resp.status = 0x01;
+  auto* om = ble_hs_mbuf_from_flat(&resp, sizeof(HashResponse));
+  if (om == nullptr) {
+    return;
+  }
+
+  // The response holds the entries that fit in one notification (or one frame), the client asks for the others again
+  uint16_t maxSize = MaxResponseSize(connectionHandle);
+  uint16_t maxEntries = (maxSize > sizeof(HashResponse)) ? (maxSize - sizeof(HashResponse)) / sizeof(HashEntry) : 0;
+  uint16_t pathCount = 0;
+  uint32_t offset = sizeof(HashHeader);
+  if (size >= sizeof(HashHeader)) {
+    pathCount = reinterpret_cast<const HashHeader*>(data)->pathCount;
   } else {
-    lfs_file f;
-    resp->chunklen = std::min(header->chunksize, info.size);
-    resp->totallen = info.size;
-    fs.FileOpen(&f, filepath, LFS_O_RDONLY);
-    fs.FileSeek(&f, header->chunkoff);
-    resp->chunklen = fs.FileRead(&f, resp->chunk, resp->chunklen);
-    fs.FileClose(&f);
+    resp.status = (int8_t) LFS_ERR_INVAL;
   }
+
+  while (resp.entryCount < pathCount && resp.entryCount < maxEntries) {
+    uint16_t plen;
+    if (offset + sizeof(plen) > size) {
+      resp.status = (int8_t) LFS_ERR_INVAL;
+      break;
+    }
+    memcpy(&plen, data + offset, sizeof(plen));
+    offset += sizeof(plen);
+    if (plen >= maxpathlen || offset + plen > size) {
+      resp.status = (int8_t) LFS_ERR_INVAL;
+      break;
+    }
+    char path[plen + 1];
+    memcpy(path, data + offset, plen);
+    path[plen] = 0; // Copy and null terminate string
+    offset += plen;
+
+    FS::ContentHash hash {};
+    int res = fs.GetContentHash(path, hash);
+    HashEntry entry {};
+    entry.status = (res == 0) ? 0x01 : (int8_t) res;
+    entry.size = hash.size;
+    entry.crc = hash.crc;
+    if (os_mbuf_append(om, &entry, sizeof(HashEntry)) != 0) {
+      break;
+    }
+    resp.entryCount++;
+  }
+
+  os_mbuf_copyinto(om, 0, &resp, sizeof(HashResponse));
+  Respond(connectionHandle, om);
+}
+
+void FSService::OnSessionTimeout() {
+  NRF_LOG_INFO("[FS_S] -> Transfer timeout");
+  CloseSession();
+}
+
+void FSService::ContinueListing() {
+  // Entries are never split between frames, but one that is larger than the MTU is sent alone (truncated)
+  uint16_t payloadSize = MaxResponseSize(listConnectionHandle);
+  while (listing) {
+    os_mbuf* om = nullptr;
+    if (CanRespond() && os_msys_num_free() >= listMinFreeBuffers) {
+      om = ble_hs_mbuf_att_pkt();
+    }
+    if (om == nullptr) {
+      // Buffers are freed as notifications are sent (or credits are received on the L2CAP channel). The device stays
+      // awake until the last entry is sent.
+      if (!listWakeLock) {
+        systemTask.PushMessage(Pinetime::System::Messages::StartFileTransfer);
+        listWakeLock = true;
+      }
+      ble_npl_callout_reset(&listRetryCallout, listRetryDelay);
+      return;
+    }
+
+    uint16_t length = 0;
+    bool last = false;
+    while (!last && (hasListEntry || ReadListEntry())) {
+      uint16_t entrySize = sizeof(ListDirResponse) + reinterpret_cast<ListDirResponse*>(listEntry)->path_length;
+      if (length > 0 && (!listPacked || length + entrySize > payloadSize)) {
+        break;
+      }
+      if (os_mbuf_append(om, listEntry, entrySize) != 0) {
+        os_mbuf_free_chain(om);
+        CloseListing();
+        return;
+      }
+      length += entrySize;
+      hasListEntry = false;
+      last = listEnded;
+    }
+
+    // The notification is freed by the stack, even if it fails
+    if (Respond(listConnectionHandle, om) != 0 || last) {
+      CloseListing();
+    }
+  }
+}
+
+bool FSService::ReadListEntry() {
+  if (listEnded) {
+    return false;
+  }
+  lfs_info info;
+  int res = fs.DirRead(&listDir, &info);
+  auto* entry = reinterpret_cast<ListDirResponse*>(listEntry);
+  entry->command = commands::LISTDIR_ENTRY;
+  entry->status = 0x01;
+  entry->totalentries = listTotalEntries;
+  entry->modification_time = 0;
+  entry->entry = listNextEntry;
+  if (res <= 0) {
+    // Last response: no entry, its index is the number of entries
+    listEnded = true;
+    entry->flags = 0;
+    entry->file_size = 0;
+    entry->path_length = 0;
+  } else {
+    entry->flags = (info.type == LFS_TYPE_DIR) ? 1 : 0;
+    entry->file_size = (info.type == LFS_TYPE_DIR) ? 0 : info.size;
+    entry->path_length = std::min(strlen(info.name), FS::maxNameLength);
+    memcpy(entry->path, info.name, entry->path_length);
+    listNextEntry++;
+  }
+  hasListEntry = true;
+  return true;
+}
+
+void FSService::CloseListing() {
+  if (!listing) {
+    return;
+  }
+  listing = false;
+  ble_npl_callout_stop(&listRetryCallout);
+  fs.DirClose(&listDir);
+  if (listWakeLock) {
+    systemTask.PushMessage(Pinetime::System::Messages::StopFileTransfer);
+    listWakeLock = false;
+  }
+}
+
+int FSService::Respond(uint16_t connectionHandle, os_mbuf* om) {
+  if (overBulkTransport) {
+    return bulkTransport.Send(BulkTransport::Services::FS, om);
+  }
+  return ble_gattc_notify_custom(connectionHandle, transferCharacteristicHandle, om);
+}
+
+bool FSService::CanRespond() const {
+  return !overBulkTransport || bulkTransport.IsIdle();
+}
+
+uint16_t FSService::MaxResponseSize(uint16_t connectionHandle) const {
+  if (overBulkTransport) {
+    return bulkTransport.MaxPayloadSize();
+  }
+  return ble_att_mtu(connectionHandle) - 3;
+}
+
+void FSService::OnListDirRetry() {
+  ContinueListing();
+}
+
+void FSService::Reset() {
+  CloseSession();
+  CloseListing();
 }
@@ -5,6 +5,7 @@
 #undef max
 #undef min
 
+#include <FreeRTOS.h>
 #include "components/fs/FS.h"
 
 namespace Pinetime {
@@ -14,20 +15,30 @@ namespace Pinetime {
 
   namespace Controllers {
     class Ble;
+    class BulkTransport;
     class Settings;
     class NotificationManager;
 
     class FSService {
     public:
-      FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs);
+      FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs, BulkTransport& bulkTransport);
       void Init();
 
       int OnFSServiceRequested(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+      // Command received on the L2CAP channel, its responses are sent back on the channel
+      void OnBulkCommand(uint16_t connectionHandle, uint8_t* data, uint16_t size);
       void NotifyFSRaw(uint16_t connectionHandle);
+      void OnSessionTimeout();
+      void OnListDirRetry();
+      // Ends the transfer or the listing in progress (disconnection)
+      void Reset();
 
     private:
       Pinetime::System::SystemTask& systemTask;
       Pinetime::Controllers::FS& fs;
+      BulkTransport& bulkTransport;
+      // The command being handled (and the listing in progress) came from the L2CAP channel instead of GATT
+      bool overBulkTransport = false;
 
       static constexpr const char denyAlert[] = "InfiniTime\0File access attempted, but disabled in settings.";
       static constexpr const uint8_t denyAlertLength = sizeof(denyAlert); // for this to work denyAlert MUST be array
@@ -35,7 +46,8 @@ namespace Pinetime {
       static constexpr uint16_t FSServiceId {0xFEBB};
       static constexpr uint16_t fsVersionId {0x0100};
       static constexpr uint16_t fsTransferId {0x0200};
-      uint16_t fsVersion = {0x0004};
+      // 5: list entries packed on the L2CAP channel, HASH command
+      uint16_t fsVersion = {0x0005};
       static constexpr uint16_t maxpathlen = 256;
       static constexpr ble_uuid16_t fsServiceUuid {
         .u {.type = BLE_UUID_TYPE_16},
@@ -69,16 +81,29 @@ namespace Pinetime {
         LISTDIR = 0x50,
         LISTDIR_ENTRY = 0x51,
         MOVE = 0x60,
-        MOVE_STATUS = 0x61
+        MOVE_STATUS = 0x61,
+        HASH = 0x70,
+        HASH_STATUS = 0x71
       };
       enum class FSState : uint8_t {
         IDLE = 0x00,
         READ = 0x01,
         WRITE = 0x02,
       };
-      FSState state;
+      // Transfer in progress (READ or WRITE): its file stays open between the chunks instead of being opened, seeked
+      // and closed for each of them. It is closed when the transfer completes, on any other command, on disconnection
+      // and when no chunk was received for sessionTimeout.
+      FSState state = FSState::IDLE;
       char filepath[maxpathlen]; // TODO ..ugh fixed filepath len
       int fileSize;
+      lfs_file_t file;
+      // Offset of the next chunk, chunks at other offsets are rejected
+      uint32_t cursor = 0;
+      // CRC-32 of the data written since the beginning of the file, stored as its content hash once it is complete
+      uint32_t writeCrc = 0;
+      bool writeFromStart = false;
+      static constexpr TickType_t sessionTimeout = pdMS_TO_TICKS(10000);
+      ble_npl_callout sessionCallout;
 
       using ReadHeader = struct __attribute__((packed)) {
         commands command;
@@ -196,8 +221,57 @@ namespace Pinetime {
         uint8_t status;
       };
 
-      int FSCommandHandler(uint16_t connectionHandle, os_mbuf* om);
-      void prepareReadDataResp(ReadHeader* header, ReadResponse* resp);
+      // Followed by pathCount paths, each one a uint16_t length and the path
+      using HashHeader = struct __attribute__((packed)) {
+        commands command;
+        uint8_t padding;
+        uint16_t pathCount;
+        uint8_t paths[];
+      };
+
+      using HashResponse = struct __attribute__((packed)) {
+        commands command;
+        uint8_t status;
+        uint16_t entryCount;
+      };
+
+      using HashEntry = struct __attribute__((packed)) {
+        uint8_t status;
+        uint8_t padding[3];
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      // Directory being listed by LISTDIR. Its entries are sent as the BLE stack has buffers for them, and the host
+      // task is released while waiting for the buffers. GATT clients expect one entry per notification, several
+      // entries are packed in each frame on the L2CAP channel (listPacked).
+      bool listing = false;
+      lfs_dir_t listDir;
+      uint16_t listConnectionHandle = 0;
+      bool listPacked = false;
+      uint32_t listTotalEntries = 0;
+      uint32_t listNextEntry = 0;
+      bool listWakeLock = false;
+      // Next entry to send (ListDirResponse and its path), read from the directory but not sent yet if hasListEntry
+      bool hasListEntry = false;
+      bool listEnded = false;
+      uint8_t listEntry[sizeof(ListDirResponse) + FS::maxNameLength];
+      ble_npl_callout listRetryCallout;
+      // Buffers left for the other services and the incoming packets
+      static constexpr uint16_t listMinFreeBuffers = 4;
+      static constexpr TickType_t listRetryDelay = pdMS_TO_TICKS(10);
+
+      int FSCommandHandler(uint16_t connectionHandle, uint8_t* data, uint16_t size);
+      void SendHashes(uint16_t connectionHandle, const uint8_t* data, uint16_t size);
+      int Respond(uint16_t connectionHandle, os_mbuf* om);
+      bool CanRespond() const;
+      uint16_t MaxResponseSize(uint16_t connectionHandle) const;
+      void ContinueListing();
+      bool ReadListEntry();
+      void CloseListing();
+      int OpenSession(FSState newState, int flags, uint32_t offset);
+      int CloseSession();
+      void SendReadData(uint16_t connectionHandle, uint32_t offset, uint32_t chunkSize);
     };
   }
 }
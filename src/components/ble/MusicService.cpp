@@ -222,3 +222,11 @@ void Pinetime::Controllers::MusicService::event(char event) {
 
   ble_gattc_notify_custom(connectionHandle, eventHandle, om);
 }
+
+void Pinetime::Controllers::MusicService::StartSession() {
+  nimble.ConnectionActivityStarted(NimbleController::ConnectionActivities::Music);
+}
+
+void Pinetime::Controllers::MusicService::StopSession() {
+  nimble.ConnectionActivityStopped(NimbleController::ConnectionActivities::Music);
+}
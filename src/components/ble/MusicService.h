@@ -41,6 +41,10 @@ namespace Pinetime {
 
       void event(char event);
 
+      // The music app is open: the connection stays fast so that the controls and the track info respond quickly
+      void StartSession();
+      void StopSession();
+
       std::string getArtist() const;
 
       std::string getTrack() const;
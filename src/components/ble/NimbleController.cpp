@@ -1,4 +1,5 @@
 #include "components/ble/NimbleController.h"
+#include <algorithm>
 #include <cstring>
 
 #include <nrf_log.h>
@@ -8,6 +9,7 @@
 #include <host/ble_hs.h>
 #include <host/ble_hs_id.h>
 #include <host/util/util.h>
+#include <nimble/nimble_port.h>
 #include <controller/ble_ll.h>
 #include <controller/ble_hw.h>
 #include <services/gap/ble_svc_gap.h>
@@ -22,6 +24,25 @@
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  // Within the Accessory Design Guidelines of Apple: interval of at least 15 ms, at most 2 s between the connection
+  // events the peripheral listens to, and a supervision timeout between 2 s and 6 s, over 3 times that period.
+  // Transfers: 15 to 30 ms.
+  constexpr ble_gap_upd_params activeConnectionParameters {.itvl_min = 12,
+                                                           .itvl_max = 24,
+                                                           .latency = 0,
+                                                           .supervision_timeout = 400,
+                                                           .min_ce_len = 0,
+                                                           .max_ce_len = 0};
+  // Idle: 150 to 200 ms, the watch may skip 4 events out of 5 when it has nothing to send.
+  constexpr ble_gap_upd_params idleConnectionParameters {.itvl_min = 120,
+                                                         .itvl_max = 160,
+                                                         .latency = 4,
+                                                         .supervision_timeout = 600,
+                                                         .min_ce_len = 0,
+                                                         .max_ce_len = 0};
+}
+
 NimbleController::NimbleController(Pinetime::System::SystemTask& systemTask,
                                    Ble& bleController,
                                    DateTime& dateTimeController,
@@ -48,7 +69,8 @@ NimbleController::NimbleController(Pinetime::System::SystemTask& systemTask,
     immediateAlertService {systemTask, notificationManager},
     heartRateService {*this, heartRateController},
     motionService {*this, motionController},
-    fsService {systemTask, fs},
+    fsService {systemTask, fs, bulkTransport},
+    bulkTransport {systemTask, fsService, dfuService},
     serviceDiscovery({&currentTimeClient, &alertNotificationClient}) {
 }
 
@@ -72,6 +94,11 @@ int GAPEventCallback(struct ble_gap_event* event, void* arg) {
   return nimbleController->OnGAPEvent(event);
 }
 
+void ConnectionPolicyCallback(ble_npl_event* event) {
+  auto* nimbleController = static_cast<NimbleController*>(ble_npl_event_get_arg(event));
+  nimbleController->ApplyConnectionPolicy();
+}
+
 void NimbleController::Init() {
   while (!ble_hs_synced()) {
     vTaskDelay(10);
@@ -85,6 +112,8 @@ void NimbleController::Init() {
   ble_svc_gap_init();
   ble_svc_gatt_init();
 
+  ble_npl_callout_init(&connectionPolicyCallout, nimble_port_get_dflt_eventq(), ConnectionPolicyCallback, this);
+
   deviceInformationService.Init();
   currentTimeClient.Init();
   currentTimeService.Init();
@@ -98,6 +127,7 @@ void NimbleController::Init() {
   heartRateService.Init();
   motionService.Init();
   fsService.Init();
+  bulkTransport.Init();
 
   int rc;
   rc = ble_hs_util_ensure_addr(0);
@@ -209,6 +239,8 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
         bleController.Connect();
         systemTask.PushMessage(Pinetime::System::Messages::BleConnected);
         // Service discovery is deferred via systemtask
+        connectionProfile = ConnectionProfiles::Central;
+        ble_npl_callout_reset(&connectionPolicyCallout, connectionSettleDelay);
       }
       break;
 
@@ -223,6 +255,10 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
 
       currentTimeClient.Reset();
       alertNotificationClient.Reset();
+      fsService.Reset();
+      bulkTransport.Reset();
+      ble_npl_callout_stop(&connectionPolicyCallout);
+      connectionProfile = ConnectionProfiles::Central;
       connectionHandle = BLE_HS_CONN_HANDLE_NONE;
       if (bleController.IsConnected()) {
         bleController.Disconnect();
@@ -235,6 +271,20 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
       /* The central has updated the connection parameters. */
       NRF_LOG_INFO("Update event : BLE_GAP_EVENT_CONN_UPDATE");
       NRF_LOG_INFO("update status=%0X ", event->conn_update.status);
+      if (event->conn_update.status == 0) {
+        struct ble_gap_conn_desc desc;
+        if (ble_gap_conn_find(event->conn_update.conn_handle, &desc) == 0) {
+          NRF_LOG_INFO("new parameters : itvl=%d latency=%d supervision=%d", desc.conn_itvl, desc.conn_latency, desc.supervision_timeout);
+        }
+      } else if (connectionProfile != ConnectionProfiles::Central) {
+        // Refused by the central: requested again on the next change of activity
+        connectionProfile = ConnectionProfiles::Central;
+      }
+      break;
+
+    case BLE_GAP_EVENT_PHY_UPDATE_COMPLETE:
+      NRF_LOG_INFO("PHY event : BLE_GAP_EVENT_PHY_UPDATE_COMPLETE");
+      NRF_LOG_INFO("status=%0X tx_phy=%d rx_phy=%d", event->phy_updated.status, event->phy_updated.tx_phy, event->phy_updated.rx_phy);
       break;
 
     case BLE_GAP_EVENT_CONN_UPDATE_REQ:
@@ -420,6 +470,56 @@ void NimbleController::DisableRadio() {
   }
 }
 
+void NimbleController::ConnectionActivityStarted(ConnectionActivities activity) {
+  connectionActivities[static_cast<uint8_t>(activity)]++;
+  ble_npl_callout_reset(&connectionPolicyCallout, 0);
+}
+
+void NimbleController::ConnectionActivityStopped(ConnectionActivities activity) {
+  auto& count = connectionActivities[static_cast<uint8_t>(activity)];
+  if (count > 0) {
+    count--;
+  }
+  if (!IsConnectionActive()) {
+    ble_npl_callout_reset(&connectionPolicyCallout, connectionIdleDelay);
+  }
+}
+
+void NimbleController::ApplyConnectionPolicy() {
+  if (connectionHandle == BLE_HS_CONN_HANDLE_NONE) {
+    return;
+  }
+  ConnectionProfiles profile = IsConnectionActive() ? ConnectionProfiles::Active : ConnectionProfiles::Idle;
+  if (profile == connectionProfile) {
+    return;
+  }
+
+  const ble_gap_upd_params& parameters = (profile == ConnectionProfiles::Active) ? activeConnectionParameters : idleConnectionParameters;
+  int rc = ble_gap_update_params(connectionHandle, &parameters);
+  if (rc == BLE_HS_EALREADY) {
+    ble_npl_callout_reset(&connectionPolicyCallout, connectionRetryDelay);
+    return;
+  }
+  if (rc != 0) {
+    NRF_LOG_INFO("Connection parameters not requested, rc=%d", rc);
+    return;
+  }
+  connectionProfile = profile;
+
+  // 2M PHY halves the air time of the transfers, 1M has a better range when idle. Ignored by a central without 2M.
+  uint8_t phys = (profile == ConnectionProfiles::Active) ? BLE_GAP_LE_PHY_2M_MASK : BLE_GAP_LE_PHY_1M_MASK;
+  rc = ble_gap_set_prefered_le_phy(connectionHandle, phys, phys, BLE_GAP_LE_PHY_CODED_ANY);
+  if (rc != 0) {
+    NRF_LOG_INFO("PHY not requested, rc=%d", rc);
+  }
+}
+
+bool NimbleController::IsConnectionActive() const {
+  return std::any_of(connectionActivities.begin(), connectionActivities.end(), [](const std::atomic<uint8_t>& count) {
+    return count > 0;
+  });
+}
+
 void NimbleController::PersistBond(struct ble_gap_conn_desc& desc) {
   union ble_store_key key;
   union ble_store_value our_sec, peer_sec, peer_cccd_set[MYNEWT_VAL(BLE_STORE_MAX_CCCDS)] = {0};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 
 #define min // workaround: nimble's min/max macros conflict with libstdc++
@@ -7,9 +9,11 @@
 #include <host/ble_gap.h>
 #undef max
 #undef min
+#include <FreeRTOS.h>
 #include "components/ble/AlertNotificationClient.h"
 #include "components/ble/AlertNotificationService.h"
 #include "components/ble/BatteryInformationService.h"
+#include "components/ble/BulkTransport.h"
 #include "components/ble/CurrentTimeClient.h"
 #include "components/ble/CurrentTimeService.h"
 #include "components/ble/DeviceInformationService.h"
@@ -41,6 +45,9 @@ namespace Pinetime {
     class NimbleController {
 
     public:
+      // Activities that need a fast connection
+      enum class ConnectionActivities : uint8_t { FirmwareUpdate, FileTransfer, Music };
+
       NimbleController(Pinetime::System::SystemTask& systemTask,
                        Ble& bleController,
                        DateTime& dateTimeController,
@@ -81,9 +88,19 @@ namespace Pinetime {
       void EnableRadio();
       void DisableRadio();
 
+      // The connection follows the activities: short intervals and 2M PHY while at least one of them is active, long
+      // intervals with slave latency once they are all stopped. Can be called from any task, each start is balanced by
+      // a stop.
+      void ConnectionActivityStarted(ConnectionActivities activity);
+      void ConnectionActivityStopped(ConnectionActivities activity);
+      void ApplyConnectionPolicy();
+
     private:
+      enum class ConnectionProfiles : uint8_t { Central, Active, Idle };
+
       void PersistBond(struct ble_gap_conn_desc& desc);
       void RestoreBond();
+      bool IsConnectionActive() const;
 
       static constexpr const char* deviceName = "InfiniTime";
       Pinetime::System::SystemTask& systemTask;
@@ -106,12 +123,26 @@ namespace Pinetime {
       HeartRateService heartRateService;
       MotionService motionService;
       FSService fsService;
+      BulkTransport bulkTransport;
       ServiceDiscovery serviceDiscovery;
 
       uint8_t addrType;
       uint16_t connectionHandle = BLE_HS_CONN_HANDLE_NONE;
       uint8_t fastAdvCount = 0;
       uint8_t bondId[16] = {0};
+
+      // Number of starts not stopped yet, by ConnectionActivities
+      std::array<std::atomic<uint8_t>, 3> connectionActivities {};
+      // Central: the parameters chosen by the central are kept
+      ConnectionProfiles connectionProfile = ConnectionProfiles::Central;
+      // Runs in the host task
+      ble_npl_callout connectionPolicyCallout;
+      // The central chooses the parameters while it discovers the services and synchronizes
+      static constexpr TickType_t connectionSettleDelay = pdMS_TO_TICKS(5000);
+      // Activities that follow each other (FS commands) don't go through the idle profile
+      static constexpr TickType_t connectionIdleDelay = pdMS_TO_TICKS(5000);
+      // A connection parameter update is already in progress
+      static constexpr TickType_t connectionRetryDelay = pdMS_TO_TICKS(1000);
     };
 
     static NimbleController* nptr;
@@ -78,6 +78,16 @@ std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> Dat
   return currentDateTime;
 }
 
+TickType_t DateTime::TicksUntilNextSecond() {
+  xSemaphoreTake(mutex, portMAX_DELAY);
+  uint32_t systickCounter = nrf_rtc_counter_get(portNRF_RTC_REG);
+  UpdateTime(systickCounter, false);
+  // The RTC counter is 24 bits wide, mask the difference to handle its overflow
+  uint32_t elapsed = (systickCounter - previousSystickCounter) & static_cast<uint32_t>(portNRF_RTC_MAXTICKS);
+  xSemaphoreGive(mutex);
+  return configTICK_RATE_HZ - elapsed;
+}
+
 void DateTime::UpdateTime(uint32_t systickCounter, bool forceUpdate) {
   // Handle systick counter overflow
   uint32_t systickDelta = 0;
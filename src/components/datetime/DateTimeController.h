@@ -132,6 +132,12 @@ namespace Pinetime {
         return CurrentDateTime() - std::chrono::seconds((tzOffset + dstOffset) * 15 * 60);
       }
 
+      /*
+       * returns the number of system ticks left before the seconds counter advances.
+       * Used by screens that only need to be redrawn when the displayed time changes.
+       */
+      TickType_t TicksUntilNextSecond();
+
       std::chrono::seconds Uptime() const {
         return uptime;
       }
@@ -2,11 +2,14 @@
 #include <cstring>
 #include <littlefs/lfs.h>
 #include <lvgl/lvgl.h>
+#include "utility/Crc32.h"
 
 using namespace Pinetime::Controllers;
 
 FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
   : flashDriver {driver},
+    flashCache {driver},
+    resources {*this},
     lfsConfig {
       .context = this,
       .read = SectorRead,
@@ -23,12 +26,13 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
       .cache_size = 16,
       .lookahead_size = 16,
 
-      .name_max = 50,
+      .name_max = maxNameLength,
       .attr_max = 50,
     } {
 }
 
 void FS::Init() {
+  flashCache.Init();
 
   // try mount
   int err = lfs_mount(&lfs, &lfsConfig);
@@ -49,11 +53,19 @@ void FS::Init() {
 }
 
 void FS::VerifyResource() {
-  // validate the resource metadata
-  resourcesValid = true;
+  // The resources are still available from their own files if the pack is missing or corrupted
+  resourcesValid = resources.Load();
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
+  if ((flags & LFS_O_TRUNC) != 0) {
+    modificationCount++;
+  }
+  ContentHash hash;
+  if ((flags & LFS_O_WRONLY) != 0 && lfs_getattr(&lfs, fileName, contentHashAttribute, &hash, sizeof(hash)) >= 0) {
+    // The content may change
+    lfs_removeattr(&lfs, fileName, contentHashAttribute);
+  }
   return lfs_file_open(&lfs, file_p, fileName, flags);
 }
 
@@ -66,6 +78,7 @@ int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
 }
 
 int FS::FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size) {
+  modificationCount++;
   return lfs_file_write(&lfs, file_p, buff, size);
 }
 
@@ -73,7 +86,12 @@ int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
   return lfs_file_seek(&lfs, file_p, pos, LFS_SEEK_SET);
 }
 
+int FS::FileSize(lfs_file_t* file_p) {
+  return lfs_file_size(&lfs, file_p);
+}
+
 int FS::FileDelete(const char* fileName) {
+  modificationCount++;
   return lfs_remove(&lfs, fileName);
 }
 
@@ -98,6 +116,7 @@ int FS::DirCreate(const char* path) {
 }
 
 int FS::Rename(const char* oldPath, const char* newPath) {
+  modificationCount++;
   return lfs_rename(&lfs, oldPath, newPath);
 }
 
@@ -105,6 +124,56 @@ int FS::Stat(const char* path, lfs_info* info) {
   return lfs_stat(&lfs, path, info);
 }
 
+lfs_ssize_t FS::GetAttribute(const char* path, uint8_t type, void* buffer, lfs_size_t size) {
+  return lfs_getattr(&lfs, path, type, buffer, size);
+}
+
+int FS::SetAttribute(const char* path, uint8_t type, const void* buffer, lfs_size_t size) {
+  return lfs_setattr(&lfs, path, type, buffer, size);
+}
+
+int FS::SetAttributes(const char* path, const lfs_attr* attributes, lfs_size_t count) {
+  // Attributes given to lfs_file_opencfg() are committed together with the file when it is closed.
+  // The file is not written to, its content is unchanged
+  lfs_file_t file;
+  const lfs_file_config config {nullptr, const_cast<lfs_attr*>(attributes), count};
+  int result = lfs_file_opencfg(&lfs, &file, path, LFS_O_WRONLY, &config);
+  if (result != LFS_ERR_OK) {
+    return result;
+  }
+  return lfs_file_close(&lfs, &file);
+}
+
+int FS::GetContentHash(const char* path, ContentHash& hash) {
+  if (lfs_getattr(&lfs, path, contentHashAttribute, &hash, sizeof(hash)) == static_cast<lfs_ssize_t>(sizeof(hash))) {
+    return LFS_ERR_OK;
+  }
+
+  // Not written over BLE, or opened for writing since
+  lfs_file_t file;
+  int res = lfs_file_open(&lfs, &file, path, LFS_O_RDONLY);
+  if (res < 0) {
+    return res;
+  }
+  hash = {};
+  uint8_t buffer[256];
+  while ((res = lfs_file_read(&lfs, &file, buffer, sizeof(buffer))) > 0) {
+    hash.crc = Utility::Crc32(buffer, res, hash.crc);
+    hash.size += res;
+  }
+  lfs_file_close(&lfs, &file);
+  if (res < 0) {
+    return res;
+  }
+  // The hash is still valid if it can't be stored
+  SetContentHash(path, hash);
+  return LFS_ERR_OK;
+}
+
+int FS::SetContentHash(const char* path, const ContentHash& hash) {
+  return lfs_setattr(&lfs, path, contentHashAttribute, &hash, sizeof(hash));
+}
+
 lfs_ssize_t FS::GetFSSize() {
   return lfs_fs_size(&lfs);
 }
@@ -121,20 +190,20 @@ int FS::SectorSync(const struct lfs_config* /*c*/) {
 int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize);
-  lfs.flashDriver.SectorErase(address);
+  lfs.flashCache.Erase(address, blockSize);
   return lfs.flashDriver.EraseFailed() ? -1 : 0;
 }
 
 int FS::SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Write(address, (uint8_t*) buffer, size);
+  lfs.flashCache.Write(address, static_cast<const uint8_t*>(buffer), size);
   return lfs.flashDriver.ProgramFailed() ? -1 : 0;
 }
 
 int FS::SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
   const size_t address = startAddress + (block * blockSize) + off;
-  lfs.flashDriver.Read(address, static_cast<uint8_t*>(buffer), size);
+  lfs.flashCache.Read(address, static_cast<uint8_t*>(buffer), size);
   return 0;
 }
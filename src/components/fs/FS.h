@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include "drivers/SpiNorFlash.h"
+#include "components/fs/FlashCache.h"
+#include "components/fs/ResourceStore.h"
 #include <littlefs/lfs.h>
 
 namespace Pinetime {
@@ -17,6 +19,7 @@ namespace Pinetime {
       int FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size);
       int FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size);
       int FileSeek(lfs_file_t* file_p, uint32_t pos);
+      int FileSize(lfs_file_t* file_p);
 
       int FileDelete(const char* fileName);
 
@@ -29,8 +32,39 @@ namespace Pinetime {
       lfs_ssize_t GetFSSize();
       int Rename(const char* oldPath, const char* newPath);
       int Stat(const char* path, lfs_info* info);
+      lfs_ssize_t GetAttribute(const char* path, uint8_t type, void* buffer, lfs_size_t size);
+      int SetAttribute(const char* path, uint8_t type, const void* buffer, lfs_size_t size);
+      // Writes all the attributes in a single metadata commit: after a reset, either all of them or none are updated
+      int SetAttributes(const char* path, const lfs_attr* attributes, lfs_size_t count);
       void VerifyResource();
 
+      // CRC-32 and size of the content of a file, kept in an attribute of the file. The attribute is removed when the
+      // file is opened for writing, GetContentHash() reads the whole file to compute it again.
+      struct __attribute__((packed)) ContentHash {
+        uint32_t crc;
+        uint32_t size;
+      };
+      int GetContentHash(const char* path, ContentHash& hash);
+      int SetContentHash(const char* path, const ContentHash& hash);
+
+      // Fonts and images: from the resource pack when it is installed and valid, otherwise from their own files
+      ResourceStore& Resources() {
+        return resources;
+      }
+
+      const FlashCache::Statistics& GetCacheStatistics() const {
+        return flashCache.GetStatistics();
+      }
+
+      // Changes every time the content of a file is modified, a file is deleted or renamed.
+      // littlefs doesn't record modification times: caches of file content compare this instead
+      uint32_t GetModificationCount() const {
+        return modificationCount;
+      }
+
+      // Longest file or directory name
+      static constexpr size_t maxNameLength = 50;
+
       static size_t getSize() {
         return size;
       }
@@ -41,6 +75,8 @@ namespace Pinetime {
 
     private:
       Pinetime::Drivers::SpiNorFlash& flashDriver;
+      FlashCache flashCache;
+      ResourceStore resources;
 
       /*
        * External Flash MAP (4 MBytes)
@@ -69,6 +105,9 @@ namespace Pinetime {
       static constexpr size_t blockSize = 4096;
 
       bool resourcesValid = false;
+      uint32_t modificationCount = 0;
+      // KeyValueStore numbers its attributes from 0
+      static constexpr uint8_t contentHashAttribute = 0xF0;
       const struct lfs_config lfsConfig;
 
       lfs_t lfs;
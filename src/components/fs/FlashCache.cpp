@@ -0,0 +1,165 @@
+#include "components/fs/FlashCache.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace Pinetime::Controllers;
+
+FlashCache::FlashCache(Pinetime::Drivers::SpiNorFlash& flashDriver) : flashDriver {flashDriver} {
+}
+
+void FlashCache::Init() {
+  if (readAheadDone == nullptr) {
+    readAheadDone = xSemaphoreCreateBinary();
+  }
+}
+
+void FlashCache::Read(uint32_t address, uint8_t* buffer, size_t size) {
+  if (nbPages == 0 || size > maxCachedReadSize) {
+    statistics.bypassed++;
+    flashDriver.Read(address, buffer, size);
+    return;
+  }
+
+  while (size > 0) {
+    const uint32_t pageNumber = address / pageSize;
+    const size_t offset = address % pageSize;
+    const size_t length = std::min(size, pageSize - offset);
+
+    Page* page = Find(pageNumber);
+    if (page != nullptr) {
+      statistics.hits++;
+      page->lastUse = ++useCounter;
+      if (page->readAhead) {
+        // The access is sequential: keep one page ahead of the reader
+        statistics.readAheadHits++;
+        page->readAhead = false;
+        ReadAhead(pageNumber + 1);
+      }
+    } else {
+      statistics.misses++;
+      page = Load(pageNumber);
+      // A miss right after the previous page: the reader is probably walking through a block
+      if (pageNumber > 0 && Find(pageNumber - 1) != nullptr) {
+        ReadAhead(pageNumber + 1);
+      }
+    }
+
+    std::memcpy(buffer, page->data + offset, length);
+    address += length;
+    buffer += length;
+    size -= length;
+  }
+}
+
+void FlashCache::Write(uint32_t address, const uint8_t* buffer, size_t size) {
+  WaitForReadAhead();
+  flashDriver.Write(address, buffer, size);
+  if (flashDriver.ProgramFailed()) {
+    Invalidate(address, size);
+    return;
+  }
+
+  // Programming can only clear bits, apply the same to the cached copy instead of reading it back
+  for (auto& page : pages) {
+    if (!page.valid) {
+      continue;
+    }
+    const uint32_t pageStart = page.number * pageSize;
+    const uint32_t start = std::max(pageStart, address);
+    const uint32_t end = std::min(pageStart + pageSize, address + size);
+    for (uint32_t i = start; i < end; i++) {
+      page.data[i - pageStart] &= buffer[i - address];
+    }
+  }
+}
+
+void FlashCache::Erase(uint32_t sectorAddress, size_t sectorSize) {
+  WaitForReadAhead();
+  flashDriver.SectorErase(sectorAddress);
+  Invalidate(sectorAddress, sectorSize);
+}
+
+FlashCache::Page* FlashCache::Find(uint32_t pageNumber) {
+  if (readAheadPage != nullptr && readAheadPage->number == pageNumber) {
+    WaitForReadAhead();
+  }
+
+  for (auto& page : pages) {
+    if (page.valid && page.number == pageNumber) {
+      return &page;
+    }
+  }
+  return nullptr;
+}
+
+FlashCache::Page* FlashCache::Load(uint32_t pageNumber) {
+  Page* page = LeastRecentlyUsed();
+  page->valid = false;
+  flashDriver.Read(pageNumber * pageSize, page->data, pageSize);
+  page->number = pageNumber;
+  page->lastUse = ++useCounter;
+  page->readAhead = false;
+  page->valid = true;
+  return page;
+}
+
+FlashCache::Page* FlashCache::LeastRecentlyUsed() {
+  Page* oldest = nullptr;
+  for (auto& page : pages) {
+    if (&page == readAheadPage) {
+      continue;
+    }
+    if (!page.valid) {
+      return &page;
+    }
+    if (oldest == nullptr || page.lastUse < oldest->lastUse) {
+      oldest = &page;
+    }
+  }
+  return oldest;
+}
+
+void FlashCache::ReadAhead(uint32_t pageNumber) {
+  // One page must stay available for the reader
+  if (nbPages < 2 || Find(pageNumber) != nullptr) {
+    return;
+  }
+  WaitForReadAhead();
+
+  Page* page = LeastRecentlyUsed();
+  page->valid = false;
+  page->number = pageNumber;
+  page->readAhead = true;
+  readAheadPage = page;
+  if (!flashDriver.ReadAsync(pageNumber * pageSize, page->data, pageSize, OnReadAheadDone, this)) {
+    readAheadPage = nullptr;
+  }
+}
+
+void FlashCache::WaitForReadAhead() {
+  if (readAheadPage == nullptr) {
+    return;
+  }
+  xSemaphoreTake(readAheadDone, portMAX_DELAY);
+  Page* page = readAheadPage;
+  readAheadPage = nullptr;
+  // Oldest use, so that a read-ahead page that is never read is the first one to be evicted
+  page->lastUse = 0;
+  page->valid = true;
+}
+
+void FlashCache::Invalidate(uint32_t address, size_t size) {
+  for (auto& page : pages) {
+    const uint32_t pageStart = page.number * pageSize;
+    if (pageStart < address + size && address < pageStart + pageSize) {
+      page.valid = false;
+    }
+  }
+}
+
+void FlashCache::OnReadAheadDone(void* instance) {
+  auto* cache = static_cast<FlashCache*>(instance);
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  xSemaphoreGiveFromISR(cache->readAheadDone, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include "drivers/SpiNorFlash.h"
+
+// Number of flash pages kept in RAM between littlefs and the external flash, set with -DFS_CACHE_PAGES=n.
+// 0 disables the cache.
+#ifndef FS_CACHE_PAGES
+  #define FS_CACHE_PAGES 4
+#endif
+
+namespace Pinetime {
+  namespace Controllers {
+    // Page cache for the external flash: LRU eviction, read-ahead of the next page on sequential access
+    // and write-through programming, so the flash always holds the same data as the cache.
+    class FlashCache {
+    public:
+      struct Statistics {
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        // Reads served from a page loaded by read-ahead
+        uint32_t readAheadHits = 0;
+        // Reads too large to be cached, sent directly to the flash
+        uint32_t bypassed = 0;
+      };
+
+      explicit FlashCache(Pinetime::Drivers::SpiNorFlash& flashDriver);
+
+      void Init();
+
+      void Read(uint32_t address, uint8_t* buffer, size_t size);
+      void Write(uint32_t address, const uint8_t* buffer, size_t size);
+      void Erase(uint32_t sectorAddress, size_t sectorSize);
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
+    private:
+      static constexpr size_t pageSize = 256;
+      static constexpr size_t nbPages = FS_CACHE_PAGES;
+      // Larger reads (file content, fonts, images) stream through without evicting metadata
+      static constexpr size_t maxCachedReadSize = 2 * pageSize;
+
+      struct Page {
+        uint32_t number = 0;
+        uint32_t lastUse = 0;
+        bool valid = false;
+        bool readAhead = false;
+        uint8_t data[pageSize];
+      };
+
+      Page* Find(uint32_t pageNumber);
+      Page* Load(uint32_t pageNumber);
+      Page* LeastRecentlyUsed();
+      void ReadAhead(uint32_t pageNumber);
+      void WaitForReadAhead();
+      void Invalidate(uint32_t address, size_t size);
+      static void OnReadAheadDone(void* instance);
+
+      Pinetime::Drivers::SpiNorFlash& flashDriver;
+      // std::array: nbPages can be 0
+      std::array<Page, nbPages> pages;
+      uint32_t useCounter = 0;
+
+      // At most one read-ahead is in flight, its page is not valid until WaitForReadAhead() returns
+      Page* readAheadPage = nullptr;
+      SemaphoreHandle_t readAheadDone = nullptr;
+
+      Statistics statistics;
+    };
+  }
+}
@@ -0,0 +1,97 @@
+#include "components/fs/KeyValueStore.h"
+#include <algorithm>
+#include <cstring>
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Controllers;
+
+KeyValueStore::KeyValueStore(FS& fs, const char* path) : fs {fs}, path {path} {
+}
+
+bool KeyValueStore::Open() {
+  if (opened) {
+    return true;
+  }
+
+  lfs_info info;
+  if (fs.Stat(path, &info) != LFS_ERR_OK) {
+    // Create the parent directory and the file the attributes are attached to
+    const char* separator = std::strrchr(path, '/');
+    if (separator != nullptr && separator != path) {
+      char parent[LFS_NAME_MAX + 1];
+      size_t length = std::min<size_t>(separator - path, LFS_NAME_MAX);
+      std::memcpy(parent, path, length);
+      parent[length] = '\0';
+      fs.DirCreate(parent);
+    }
+    lfs_file_t file;
+    if (fs.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
+      return false;
+    }
+    fs.FileClose(&file);
+  }
+  opened = true;
+  return true;
+}
+
+bool KeyValueStore::Get(uint8_t key, void* value, size_t size) {
+  return Open() && fs.GetAttribute(path, key, value, size) == static_cast<lfs_ssize_t>(size);
+}
+
+bool KeyValueStore::Put(uint8_t key, const void* value, size_t size) {
+  return Open() && fs.SetAttribute(path, key, value, size) == LFS_ERR_OK;
+}
+
+bool KeyValueStore::GetAll(void* data, size_t size) {
+  auto* bytes = static_cast<uint8_t*>(data);
+  for (size_t offset = 0; offset < size; offset += recordSize) {
+    if (!Get(static_cast<uint8_t>(offset / recordSize), bytes + offset, std::min(recordSize, size - offset))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool KeyValueStore::PutAll(const void* data, size_t size) {
+  if (size > maxSize || !Open()) {
+    return false;
+  }
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  lfs_attr records[maxRecords];
+  lfs_size_t count = 0;
+  for (size_t offset = 0; offset < size; offset += recordSize) {
+    records[count++] = {static_cast<uint8_t>(offset / recordSize),
+                        const_cast<uint8_t*>(bytes + offset),
+                        static_cast<lfs_size_t>(std::min(recordSize, size - offset))};
+  }
+  return fs.SetAttributes(path, records, count) == LFS_ERR_OK;
+}
+
+bool KeyValueStore::PutChanges(const void* data, void* persisted, size_t size) {
+  if (size > maxSize || !Open()) {
+    return false;
+  }
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  auto* persistedBytes = static_cast<uint8_t*>(persisted);
+  lfs_attr records[maxRecords];
+  lfs_size_t count = 0;
+  for (size_t offset = 0; offset < size; offset += recordSize) {
+    size_t length = std::min(recordSize, size - offset);
+    if (std::memcmp(bytes + offset, persistedBytes + offset, length) != 0) {
+      records[count++] = {static_cast<uint8_t>(offset / recordSize), const_cast<uint8_t*>(bytes + offset), static_cast<lfs_size_t>(length)};
+    }
+  }
+  if (count == 0) {
+    return true;
+  }
+  if (fs.SetAttributes(path, records, count) != LFS_ERR_OK) {
+    return false;
+  }
+  std::memcpy(persistedBytes, bytes, size);
+  return true;
+}
+
+void KeyValueStore::Clear() {
+  fs.FileDelete(path);
+  opened = false;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+
+    // Small values stored as littlefs attributes of a single (empty) file.
+    // littlefs appends attribute updates to the metadata log of the parent directory: storing a value costs a
+    // few bytes of programming, and blocks are only erased when littlefs compacts that log once it is full.
+    // Rewriting a regular file erases a whole data block on every save.
+    class KeyValueStore {
+    public:
+      KeyValueStore(FS& fs, const char* path);
+
+      bool Get(uint8_t key, void* value, size_t size);
+      bool Put(uint8_t key, const void* value, size_t size);
+
+      // Loads a structure saved with PutAll() or PutChanges(). Returns false if any part of it is missing.
+      bool GetAll(void* data, size_t size);
+      bool PutAll(const void* data, size_t size);
+      // Saves the parts of data that differ from persisted, a copy of what is stored, and updates persisted.
+      // The structure is split into records of recordSize bytes, so a change of one field writes one record.
+      // The records of a call are written in a single commit, a reset can't leave the structure half updated.
+      bool PutChanges(const void* data, void* persisted, size_t size);
+
+      void Clear();
+
+      // Largest structure supported by GetAll(), PutAll() and PutChanges()
+      static constexpr size_t maxSize = 64;
+
+    private:
+      static constexpr size_t recordSize = 4;
+      static constexpr size_t maxRecords = maxSize / recordSize;
+
+      bool Open();
+
+      FS& fs;
+      const char* path;
+      bool opened = false;
+    };
+  }
+}
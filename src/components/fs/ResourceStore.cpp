@@ -0,0 +1,188 @@
+#include "components/fs/ResourceStore.h"
+#include <algorithm>
+#include <cstring>
+#include "components/fs/FS.h"
+#include "utility/Crc32.h"
+
+using namespace Pinetime::Controllers;
+
+ResourceStore::ResourceStore(FS& fs) : fs {fs} {
+}
+
+bool ResourceStore::Load() {
+  checkedModificationCount = fs.GetModificationCount();
+  OpenPack(stamp);
+  return LoadIndex();
+}
+
+void ResourceStore::OpenPack(Stamp& packStamp) {
+  if (packOpen) {
+    fs.FileClose(&pack);
+    packOpen = false;
+  }
+  packStamp = {};
+
+  lfs_info info;
+  if (fs.Stat(packPath, &info) != LFS_ERR_OK || fs.FileOpen(&pack, packPath, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return;
+  }
+  packOpen = true;
+  packStamp.size = info.size;
+  if (!ReadPack(0, &packStamp.header, sizeof(Header))) {
+    packStamp.header = {};
+  }
+}
+
+bool ResourceStore::LoadIndex() {
+  loaded = false;
+  count = 0;
+  generation++;
+
+  const Header& header = stamp.header;
+  if (!packOpen || header.magic != magic || header.version != version || header.count > maxResources || header.size != stamp.size) {
+    Unload();
+    return false;
+  }
+
+  const uint32_t indexSize = header.count * sizeof(Resource);
+  if (!ReadPack(sizeof(Header), index, indexSize) ||
+      Utility::Crc32(reinterpret_cast<const uint8_t*>(index), indexSize) != header.indexCrc) {
+    Unload();
+    return false;
+  }
+
+  const uint32_t dataStart = sizeof(Header) + indexSize;
+  for (uint16_t i = 0; i < header.count; i++) {
+    const Resource& resource = index[i];
+    bool sorted = (i == 0) || resource.id > index[i - 1].id;
+    bool inBounds = resource.offset >= dataStart && resource.offset <= header.size && resource.size <= header.size - resource.offset;
+    if (!sorted || !inBounds || !CheckResource(resource)) {
+      Unload();
+      return false;
+    }
+  }
+
+  count = header.count;
+  loaded = true;
+  return true;
+}
+
+int ResourceStore::Open(File* file, const char* path) {
+  Refresh();
+  file->position = 0;
+  file->generation = generation;
+
+  const Resource* resource = Find(Id(path));
+  if (resource != nullptr) {
+    file->inPack = true;
+    file->resource = *resource;
+    return LFS_ERR_OK;
+  }
+  file->inPack = false;
+  return fs.FileOpen(&file->file, path, LFS_O_RDONLY);
+}
+
+int ResourceStore::Close(File* file) {
+  if (!file->inPack) {
+    return fs.FileClose(&file->file);
+  }
+  return LFS_ERR_OK;
+}
+
+int ResourceStore::Read(File* file, uint8_t* buffer, uint32_t size) {
+  if (!file->inPack) {
+    return fs.FileRead(&file->file, buffer, size);
+  }
+
+  Refresh();
+  if (!loaded) {
+    return LFS_ERR_IO;
+  }
+  if (file->generation != generation) {
+    // The pack was replaced since the resource was opened: keep reading it if it is still in the pack, unchanged
+    const Resource* resource = Find(file->resource.id);
+    if (resource == nullptr || resource->size != file->resource.size || resource->crc != file->resource.crc) {
+      return LFS_ERR_IO;
+    }
+    file->resource = *resource;
+    file->generation = generation;
+  }
+  size = std::min(size, file->resource.size - file->position);
+  if (!ReadPack(file->resource.offset + file->position, buffer, size)) {
+    return LFS_ERR_IO;
+  }
+  file->position += size;
+  return static_cast<int>(size);
+}
+
+int ResourceStore::Seek(File* file, uint32_t position) {
+  if (!file->inPack) {
+    return fs.FileSeek(&file->file, position);
+  }
+  if (position > file->resource.size) {
+    return LFS_ERR_INVAL;
+  }
+  file->position = position;
+  return static_cast<int>(position);
+}
+
+bool ResourceStore::Exists(const char* path) {
+  Refresh();
+  if (Find(Id(path)) != nullptr) {
+    return true;
+  }
+  lfs_info info;
+  return fs.Stat(path, &info) == LFS_ERR_OK && info.type == LFS_TYPE_REG;
+}
+
+void ResourceStore::Refresh() {
+  if (fs.GetModificationCount() == checkedModificationCount) {
+    return;
+  }
+  checkedModificationCount = fs.GetModificationCount();
+
+  // Most modifications are about other files. The pack is reopened in case it was rewritten, but its index and the CRC
+  // of its resources are only checked again if its size or its header (which contains the CRC of the index) changed.
+  Stamp current;
+  OpenPack(current);
+  if (std::memcmp(&current, &stamp, sizeof(Stamp)) != 0) {
+    stamp = current;
+    LoadIndex();
+  } else if (!loaded) {
+    Unload();
+  }
+}
+
+void ResourceStore::Unload() {
+  if (packOpen) {
+    fs.FileClose(&pack);
+    packOpen = false;
+  }
+  loaded = false;
+  count = 0;
+}
+
+const ResourceStore::Resource* ResourceStore::Find(uint32_t id) const {
+  const Resource* end = index + count;
+  const Resource* resource = std::lower_bound(index, end, id, [](const Resource& r, uint32_t value) {
+    return r.id < value;
+  });
+  return (resource != end && resource->id == id) ? resource : nullptr;
+}
+
+bool ResourceStore::ReadPack(uint32_t offset, void* buffer, uint32_t size) {
+  return fs.FileSeek(&pack, offset) >= 0 && fs.FileRead(&pack, static_cast<uint8_t*>(buffer), size) == static_cast<int>(size);
+}
+
+bool ResourceStore::CheckResource(const Resource& resource) {
+  uint8_t buffer[64];
+  uint32_t crc = 0;
+  for (uint32_t offset = 0; offset < resource.size; offset += sizeof(buffer)) {
+    uint32_t size = std::min<uint32_t>(sizeof(buffer), resource.size - offset);
+    if (!ReadPack(resource.offset + offset, buffer, size)) {
+      return false;
+    }
+    crc = Utility::Crc32(buffer, size, crc);
+  }
+  return crc == resource.crc;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <littlefs/lfs.h>
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+
+    // Fonts and images of the resource package.
+    // The package contains a pack of all the resources (generated by resources/generate-package.py), installed
+    // as a single file:
+    //
+    //   header   magic "ITRP", uint16 version, uint16 count, uint32 size of the pack, uint32 CRC-32 of the index
+    //   index    count x (uint32 id, uint32 offset, uint32 size, uint32 CRC-32), sorted by id
+    //   data     the resources, each one aligned on 4 bytes
+    //
+    // The id of a resource is the FNV-1a hash of its path. The pack stays open and its index is kept in RAM,
+    // so opening a resource is a lookup in the index instead of a walk through the littlefs directories.
+    // Resources that are not in the pack (or all of them if the pack is missing or corrupted) are opened from
+    // their own file, as installed by the packages of older versions.
+    class ResourceStore {
+    public:
+      struct Resource {
+        uint32_t id;
+        uint32_t offset;
+        uint32_t size;
+        uint32_t crc;
+      };
+
+      // Resource opened by Open()
+      struct File {
+        // Otherwise the resource is read from its own file
+        bool inPack;
+        Resource resource;
+        uint32_t position;
+        // Index of the pack in which the resource was found
+        uint32_t generation;
+        lfs_file_t file;
+      };
+
+      static constexpr uint32_t Id(const char* path) {
+        uint32_t hash = 2166136261U;
+        while (*path != '\0') {
+          hash = (hash ^ static_cast<uint8_t>(*path++)) * 16777619U;
+        }
+        return hash;
+      }
+
+      explicit ResourceStore(FS& fs);
+
+      // Opens the pack and checks its header, its index and the CRC of each resource
+      bool Load();
+
+      bool IsLoaded() const {
+        return loaded;
+      }
+
+      int Open(File* file, const char* path);
+      int Close(File* file);
+      int Read(File* file, uint8_t* buffer, uint32_t size);
+      int Seek(File* file, uint32_t position);
+      bool Exists(const char* path);
+
+    private:
+      static constexpr const char* packPath = "/resources.pack";
+      static constexpr uint32_t magic = 0x50525449; // "ITRP"
+      static constexpr uint16_t version = 1;
+      static constexpr size_t maxResources = 24;
+
+      struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t count;
+        uint32_t size;
+        uint32_t indexCrc;
+      };
+
+      // Size and header of the pack file, all zero if it is missing
+      struct Stamp {
+        uint32_t size;
+        Header header;
+      };
+
+      // Reloads the pack if it was modified since it was loaded
+      void Refresh();
+      // (Re)opens the pack and reads its stamp
+      void OpenPack(Stamp& packStamp);
+      bool LoadIndex();
+      void Unload();
+      const Resource* Find(uint32_t id) const;
+      bool ReadPack(uint32_t offset, void* buffer, uint32_t size);
+      bool CheckResource(const Resource& resource);
+
+      FS& fs;
+      lfs_file_t pack;
+      bool loaded = false;
+      bool packOpen = false;
+      Stamp stamp {};
+      // Modification count of the file system when the stamp of the pack was last checked
+      uint32_t checkedModificationCount = 0;
+      // Incremented every time the index is loaded
+      uint32_t generation = 0;
+      Resource index[maxResources];
+      uint16_t count = 0;
+    };
+  }
+}
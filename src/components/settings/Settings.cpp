@@ -4,7 +4,7 @@
 
 using namespace Pinetime::Controllers;
 
-Settings::Settings(Pinetime::Controllers::FS& fs) : fs {fs} {
+Settings::Settings(Pinetime::Controllers::FS& fs) : fs {fs}, store {fs, "/.system/settings"} {
 }
 
 void Settings::Init() {
@@ -23,25 +23,44 @@ void Settings::SaveSettings() {
 }
 
 void Settings::LoadSettingsFromFile() {
+  SettingsData bufferSettings;
+  if (store.GetAll(&bufferSettings, sizeof(bufferSettings)) && bufferSettings.version == settingsVersion) {
+    std::memcpy(&settings, &bufferSettings, sizeof(settings));
+    std::memcpy(&persistedSettings, &bufferSettings, sizeof(settings));
+    settingsPersisted = true;
+    return;
+  }
+
+  // Settings saved by a previous firmware are moved to the store
+  if (LoadLegacySettingsFile()) {
+    SaveSettingsToFile();
+    fs.FileDelete("/settings.dat");
+  }
+}
+
+bool Settings::LoadLegacySettingsFile() {
   SettingsData bufferSettings;
   lfs_file_t settingsFile;
 
   if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_RDONLY) != LFS_ERR_OK) {
-    return;
+    return false;
   }
   fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(settings));
   fs.FileClose(&settingsFile);
-  if (bufferSettings.version == settingsVersion) {
-    settings = bufferSettings;
+  if (bufferSettings.version != settingsVersion) {
+    return false;
   }
+  settings = bufferSettings;
+  return true;
 }
 
 void Settings::SaveSettingsToFile() {
-  lfs_file_t settingsFile;
-
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
-    return;
+  static_assert(sizeof(SettingsData) <= KeyValueStore::maxSize);
+  // Usually a single field changed: only its record is appended to the store
+  if (settingsPersisted) {
+    store.PutChanges(&settings, &persistedSettings, sizeof(settings));
+  } else if (store.PutAll(&settings, sizeof(settings))) {
+    std::memcpy(&persistedSettings, &settings, sizeof(settings));
+    settingsPersisted = true;
   }
-  fs.FileWrite(&settingsFile, reinterpret_cast<uint8_t*>(&settings), sizeof(settings));
-  fs.FileClose(&settingsFile);
 }
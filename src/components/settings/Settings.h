@@ -5,6 +5,7 @@
 #include <optional>
 #include "components/brightness/BrightnessController.h"
 #include "components/fs/FS.h"
+#include "components/fs/KeyValueStore.h"
 #include "displayapp/apps/Apps.h"
 #include <nrf_log.h>
 
@@ -353,6 +354,7 @@ namespace Pinetime {
 
     private:
       Pinetime::Controllers::FS& fs;
+      KeyValueStore store;
 
       static constexpr uint32_t settingsVersion = 0x000a;
 
@@ -387,6 +389,9 @@ namespace Pinetime {
 
       SettingsData settings;
       bool settingsChanged = false;
+      // Copy of the settings in the store, only the fields that differ from it are written
+      SettingsData persistedSettings;
+      bool settingsPersisted = false;
 
       uint8_t appMenu = 0;
       uint8_t settingsMenu = 0;
@@ -398,6 +403,7 @@ namespace Pinetime {
       bool dfuAndFsEnabledTillReboot = false;
 
       void LoadSettingsFromFile();
+      bool LoadLegacySettingsFile();
       void SaveSettingsToFile();
     };
   }
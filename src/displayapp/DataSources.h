@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Applications {
+    // Data a screen can subscribe to. DisplayApp only refreshes a subscribed screen when
+    // one of its sources changed, or when the displayed time needs to advance.
+    namespace DataSources {
+      enum : uint8_t {
+        None = 0,
+        Time = 1 << 0,
+        Battery = 1 << 1,
+        Ble = 1 << 2,
+        Steps = 1 << 3,
+        HeartRate = 1 << 4,
+        Notifications = 1 << 5,
+        Weather = 1 << 6,
+      };
+    }
+
+    enum class TimeResolution : uint8_t { Seconds, Minutes };
+  }
+}
@@ -247,6 +247,7 @@ void DisplayApp::Refresh() {
       // If not true, then wait that amount of time
       queueTimeout = CalculateSleepTime();
       if (queueTimeout == 0) {
+        RefreshSubscribedScreen();
         // Only advance the tick count when LVGL is done
         // Otherwise keep running the task handler while it still has things to draw
         // Note: under high graphics load, LVGL will always have more work to do
@@ -263,6 +264,7 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
+      RefreshSubscribedScreen();
       queueTimeout = lv_task_handler();
 
       if (!systemTask->IsSleepDisabled() && IsPastDimTime()) {
@@ -289,6 +291,18 @@ void DisplayApp::Refresh() {
         isDimmed = false;
         ApplyBrightness();
       }
+
+      // Screens subscribed to DataSources don't need LVGL to be polled every refresh period.
+      // When nothing is being drawn, sleep until the next data change, screen refresh or dim/sleep timeout
+      if (currentScreen->Subscriptions() != DataSources::None && IsLvglIdle()) {
+        TickType_t idleTimeout = TicksUntilScreenRefresh();
+        if (!systemTask->IsSleepDisabled()) {
+          const TickType_t inactiveTime = lv_disp_get_inactive_time(nullptr);
+          const TickType_t nextTimeout = pdMS_TO_TICKS(settingsController.GetScreenTimeOut() - (isDimmed ? 0 : 2000));
+          idleTimeout = std::min(idleTimeout, nextTimeout > inactiveTime ? nextTimeout - inactiveTime : 0);
+        }
+        queueTimeout = std::max(queueTimeout, idleTimeout);
+      }
       break;
     default:
       queueTimeout = portMAX_DELAY;
@@ -333,6 +347,7 @@ void DisplayApp::Refresh() {
         lvgl.ClearTouchState();
         if (msg == Messages::GoToAOD) {
           lcd.LowPowerOn();
+          ApplyAlwaysOnArea();
           // Record idle entry time
           alwaysOnFrameCount = 0;
           alwaysOnStartTime = xTaskGetTickCount();
@@ -355,6 +370,7 @@ void DisplayApp::Refresh() {
           break;
         }
         if (state == States::AOD) {
+          lvgl.ClearPartialArea();
           lcd.LowPowerOff();
         } else {
           lcd.Wakeup();
@@ -362,6 +378,8 @@ void DisplayApp::Refresh() {
         lv_disp_trig_activity(nullptr);
         ApplyBrightness();
         state = States::Running;
+        // Data changes are not published while sleeping, refresh the whole screen now
+        nextScreenRefresh = xTaskGetTickCount();
         break;
       case Messages::UpdateBleConnection:
         // Only used for recovery firmware
@@ -485,6 +503,12 @@ void DisplayApp::Refresh() {
         LoadNewScreen(Apps::Clock, DisplayApp::FullRefreshDirections::None);
         motorController.RunForDuration(35);
         break;
+      case Messages::DataChanged: {
+        auto sources = pendingDataChanges.exchange(DataSources::None);
+        if (state != States::Idle) {
+          currentScreen->OnDataChanged(sources);
+        }
+      } break;
     }
   }
 
@@ -519,6 +543,8 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
   lv_disp_trig_activity(nullptr);
   motorController.StopRinging();
 
+  // Keep the display statistics of the screen being left, see SystemInfo
+  lvgl.RestartStatistics();
   currentScreen.reset(nullptr);
   SetFullRefresh(direction);
 
@@ -569,6 +595,7 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                                systemTask->nimble().alertService(),
                                                                motorController,
                                                                *systemTask,
+                                                               lvgl,
                                                                Screens::Notifications::Modes::Normal);
       break;
     case Apps::NotificationsPreview:
@@ -577,6 +604,7 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                                systemTask->nimble().alertService(),
                                                                motorController,
                                                                *systemTask,
+                                                               lvgl,
                                                                Screens::Notifications::Modes::Preview);
       break;
     case Apps::QuickSettings:
@@ -646,7 +674,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             watchdog,
                                                             motionController,
                                                             touchPanel,
-                                                            spiNorFlash);
+                                                            spiNorFlash,
+                                                            filesystem,
+                                                            lvgl);
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
@@ -664,6 +694,14 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
     }
   }
   currentApp = app;
+  lvgl.SetReducedColorDepth(currentScreen->ReducedColorDepth());
+  if (state == States::AOD) {
+    ApplyAlwaysOnArea();
+  }
+
+  if (currentScreen->Subscriptions() != DataSources::None) {
+    ScheduleScreenRefresh();
+  }
 }
 
 void DisplayApp::PushMessage(Messages msg) {
@@ -676,7 +714,8 @@ void DisplayApp::PushMessage(Messages msg) {
     // Make xQueueSend() non-blocking if the message is a Notification message. We do this to avoid
     // deadlock between SystemTask and DisplayApp when their respective message queues are getting full
     // when a lot of notifications are received on a very short time span.
-    if (msg == Messages::NewNotification) {
+    // DataChanged is not critical either: pending changes are picked up on the next screen refresh.
+    if (msg == Messages::NewNotification || msg == Messages::DataChanged) {
       timeout = static_cast<TickType_t>(0);
     }
 
@@ -684,6 +723,53 @@ void DisplayApp::PushMessage(Messages msg) {
   }
 }
 
+void DisplayApp::NotifyDataChanged(uint8_t sources) {
+  if (pendingDataChanges.fetch_or(sources) == DataSources::None) {
+    PushMessage(Messages::DataChanged);
+  }
+}
+
+void DisplayApp::ScheduleScreenRefresh() {
+  // One extra tick ensures the displayed second/minute has changed when the deadline is reached
+  TickType_t period = dateTimeController.TicksUntilNextSecond() + 1;
+  if (currentScreen->GetTimeResolution() == TimeResolution::Minutes) {
+    period += (59 - dateTimeController.Seconds()) * configTICK_RATE_HZ;
+  }
+  if (currentScreen->PollPeriod() > 0) {
+    period = std::min(period, static_cast<TickType_t>(pdMS_TO_TICKS(currentScreen->PollPeriod())));
+  }
+  nextScreenRefresh = xTaskGetTickCount() + period;
+}
+
+TickType_t DisplayApp::TicksUntilScreenRefresh() const {
+  auto remaining = static_cast<int32_t>(nextScreenRefresh - xTaskGetTickCount());
+  return remaining > 0 ? static_cast<TickType_t>(remaining) : 0;
+}
+
+void DisplayApp::RefreshSubscribedScreen() {
+  if (currentScreen->Subscriptions() == DataSources::None) {
+    return;
+  }
+  // The poll period may have just been enabled (e.g. charging animation, settings menu shown)
+  const uint32_t pollPeriod = currentScreen->PollPeriod();
+  if (pollPeriod > 0 && TicksUntilScreenRefresh() > pdMS_TO_TICKS(pollPeriod)) {
+    ScheduleScreenRefresh();
+  }
+  if (TicksUntilScreenRefresh() > 0) {
+    return;
+  }
+  // Also pick up changes whose DataChanged message could not be queued
+  currentScreen->OnDataChanged(DataSources::Time | pendingDataChanges.exchange(DataSources::None));
+  ScheduleScreenRefresh();
+}
+
+bool DisplayApp::IsLvglIdle() const {
+  // Keep polling LVGL for a while after user activity so it can process the end of touch events
+  static constexpr TickType_t activityGracePeriod = pdMS_TO_TICKS(1000);
+  return lv_disp_get_default()->inv_p == 0 && lv_anim_count_running() == 0 && !touchHandler.IsTouching() &&
+         lv_disp_get_inactive_time(nullptr) >= activityGracePeriod;
+}
+
 void DisplayApp::SetFullRefresh(DisplayApp::FullRefreshDirections direction) {
   switch (direction) {
     case DisplayApp::FullRefreshDirections::Down:
@@ -740,3 +826,9 @@ void DisplayApp::ApplyBrightness() {
   }
   brightnessController.Set(brightness);
 }
+
+void DisplayApp::ApplyAlwaysOnArea() {
+  // Lines outside of the area declared by the screen are not driven, which saves panel power and display updates
+  auto area = currentScreen->GetAlwaysOnArea();
+  lvgl.SetPartialArea(area.firstLine, area.lastLine);
+}
@@ -2,6 +2,7 @@
 #include <FreeRTOS.h>
 #include <queue.h>
 #include <task.h>
+#include <atomic>
 #include <memory>
 #include <systemtask/Messages.h>
 #include "displayapp/apps/Apps.h"
@@ -18,6 +19,7 @@
 #include "touchhandler/TouchHandler.h"
 
 #include "displayapp/Messages.h"
+#include "displayapp/DataSources.h"
 #include "BootErrors.h"
 
 #include "utility/StaticStack.h"
@@ -72,6 +74,9 @@ namespace Pinetime {
                  Pinetime::Drivers::SpiNorFlash& spiNorFlash);
       void Start(System::BootErrors error);
       void PushMessage(Display::Messages msg);
+      // Notifies the current screen that some of the given DataSources changed.
+      // Changes are accumulated until DisplayApp handles them, so at most one message is queued.
+      void NotifyDataChanged(uint8_t sources);
 
       void StartApp(Apps app, DisplayApp::FullRefreshDirections direction);
 
@@ -134,6 +139,7 @@ namespace Pinetime {
       DisplayApp::FullRefreshDirections nextDirection;
       System::BootErrors bootError;
       void ApplyBrightness();
+      void ApplyAlwaysOnArea();
 
       static constexpr size_t returnAppStackSize = 10;
       Utility::StaticStack<Apps, returnAppStackSize> returnAppStack;
@@ -141,6 +147,13 @@ namespace Pinetime {
 
       bool isDimmed = false;
 
+      std::atomic<uint8_t> pendingDataChanges {DataSources::None};
+      TickType_t nextScreenRefresh = 0;
+      void ScheduleScreenRefresh();
+      TickType_t TicksUntilScreenRefresh() const;
+      void RefreshSubscribedScreen();
+      bool IsLvglIdle() const;
+
       TickType_t CalculateSleepTime();
       TickType_t alwaysOnFrameCount;
       TickType_t alwaysOnStartTime;
@@ -71,6 +71,10 @@ namespace Pinetime {
       };
 
       void PushMessage(Pinetime::Applications::Display::Messages msg);
+
+      void NotifyDataChanged(uint8_t /*sources*/) {
+      }
+
       void Register(Pinetime::System::SystemTask* systemTask);
       void Register(Pinetime::Controllers::SimpleWeatherService* weatherService);
       void Register(Pinetime::Controllers::MusicService* musicService);
@@ -0,0 +1,593 @@
+#include "displayapp/ExternalFont.h"
+#include <algorithm>
+#include <cstring>
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Binary font layout, see lv_font_loader.c
+  struct FontHeader {
+    uint32_t version;
+    uint16_t tablesCount;
+    uint16_t fontSize;
+    uint16_t ascent;
+    int16_t descent;
+    uint16_t typoAscent;
+    int16_t typoDescent;
+    uint16_t typoLineGap;
+    int16_t minY;
+    int16_t maxY;
+    uint16_t defaultAdvanceWidth;
+    uint16_t kerningScale;
+    uint8_t indexToLocFormat;
+    uint8_t glyphIdFormat;
+    uint8_t advanceWidthFormat;
+    uint8_t bitsPerPixel;
+    uint8_t xyBits;
+    uint8_t whBits;
+    uint8_t advanceWidthBits;
+    uint8_t compressionId;
+    uint8_t subpixelsMode;
+    uint8_t padding;
+  };
+
+  struct CmapTable {
+    uint32_t dataOffset;
+    uint32_t rangeStart;
+    uint16_t rangeLength;
+    uint16_t glyphIdStart;
+    uint16_t dataEntriesCount;
+    uint8_t formatType;
+    uint8_t padding;
+  };
+
+  struct Font {
+    // First member: LVGL callbacks receive a pointer to it
+    lv_font_t font;
+    lv_font_fmt_txt_dsc_t dsc;
+    Pinetime::Controllers::ResourceStore* resources;
+    char path[48];
+    uint32_t glyphTableStart;
+    // Offset of each glyph in the glyph table, followed by the size of the table
+    uint32_t* glyphOffsets;
+    uint32_t glyphCount;
+    // Size of the metrics that precede the bitmap of each glyph
+    uint8_t glyphHeaderBits;
+  };
+
+  class FileReader {
+  public:
+    FileReader(Pinetime::Controllers::ResourceStore& resources, Pinetime::Controllers::ResourceStore::File& file)
+      : resources {resources}, file {file} {
+    }
+
+    bool Seek(uint32_t position) {
+      return resources.Seek(&file, position) >= 0;
+    }
+
+    bool Read(void* buffer, uint32_t size) {
+      return resources.Read(&file, static_cast<uint8_t*>(buffer), size) == static_cast<int>(size);
+    }
+
+    template <typename T>
+    bool Read(T& value) {
+      return Read(&value, sizeof(T));
+    }
+
+    // Returns the size of the table if its label matches
+    int32_t ReadLabel(uint32_t start, const char* label) {
+      uint32_t length;
+      char name[4];
+      if (!Seek(start) || !Read(length) || !Read(name, sizeof(name)) || std::memcmp(name, label, sizeof(name)) != 0) {
+        return -1;
+      }
+      return static_cast<int32_t>(length);
+    }
+
+  private:
+    Pinetime::Controllers::ResourceStore& resources;
+    Pinetime::Controllers::ResourceStore::File& file;
+  };
+
+  // Glyph metrics are packed in bit fields, most significant bit first
+  class BitReader {
+  public:
+    explicit BitReader(const uint8_t* data) : data {data} {
+    }
+
+    uint32_t Read(uint8_t bitCount) {
+      uint32_t value = 0;
+      while (bitCount-- > 0) {
+        value = (value << 1U) | ((data[position / 8] >> (7 - (position % 8))) & 1U);
+        position++;
+      }
+      return value;
+    }
+
+    int32_t ReadSigned(uint8_t bitCount) {
+      uint32_t value = Read(bitCount);
+      if (bitCount > 0 && (value & (1U << (bitCount - 1))) != 0) {
+        value |= ~0U << bitCount;
+      }
+      return static_cast<int32_t>(value);
+    }
+
+  private:
+    const uint8_t* data;
+    uint32_t position = 0;
+  };
+
+  struct CachedGlyph {
+    const Font* font = nullptr;
+    uint32_t glyphId = 0;
+    uint32_t lastUse = 0;
+    uint8_t* bitmap = nullptr;
+    uint32_t size = 0;
+  };
+
+  constexpr size_t cacheSize = EXTERNAL_FONT_CACHE_SIZE;
+  constexpr size_t maxCachedGlyphs = 48;
+  CachedGlyph cachedGlyphs[maxCachedGlyphs];
+  size_t cacheUsed = 0;
+  uint32_t useCounter = 0;
+
+  void Evict(CachedGlyph& entry) {
+    lv_mem_free(entry.bitmap);
+    cacheUsed -= entry.size;
+    entry = {};
+  }
+
+  // Same lookup as lv_font_fmt_txt.c, which doesn't export it
+  uint32_t GlyphId(const lv_font_fmt_txt_dsc_t& dsc, uint32_t letter) {
+    for (uint16_t i = 0; i < dsc.cmap_num; i++) {
+      const lv_font_fmt_txt_cmap_t& cmap = dsc.cmaps[i];
+      uint32_t rcp = letter - cmap.range_start;
+      if (rcp > cmap.range_length) {
+        continue;
+      }
+      switch (cmap.type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+          return cmap.glyph_id_start + rcp;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL:
+          return cmap.glyph_id_start + static_cast<const uint8_t*>(cmap.glyph_id_ofs_list)[rcp];
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY:
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL: {
+          const uint16_t* end = cmap.unicode_list + cmap.list_length;
+          const uint16_t* found = std::lower_bound(cmap.unicode_list, end, rcp);
+          if (found == end || *found != rcp) {
+            break;
+          }
+          auto index = static_cast<uint32_t>(found - cmap.unicode_list);
+          if (cmap.type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY) {
+            return cmap.glyph_id_start + index;
+          }
+          return cmap.glyph_id_start + static_cast<const uint16_t*>(cmap.glyph_id_ofs_list)[index];
+        }
+      }
+    }
+    return 0;
+  }
+
+  uint32_t BitmapSize(const Font& font, uint32_t glyphId) {
+    return font.glyphOffsets[glyphId + 1] - font.glyphOffsets[glyphId] - font.glyphHeaderBits / 8;
+  }
+
+  bool ReadBitmap(const Font& font, FileReader& reader, uint32_t glyphId, uint8_t* bitmap) {
+    uint32_t size = BitmapSize(font, glyphId);
+    if (!reader.Seek(font.glyphTableStart + font.glyphOffsets[glyphId] + font.glyphHeaderBits / 8) || !reader.Read(bitmap, size)) {
+      return false;
+    }
+    // The bitmap starts right after the metrics, not necessarily on a byte boundary
+    uint8_t shift = font.glyphHeaderBits % 8;
+    if (shift != 0) {
+      for (uint32_t i = 0; i < size; i++) {
+        uint8_t next = (i + 1 < size) ? bitmap[i + 1] : 0;
+        bitmap[i] = static_cast<uint8_t>((bitmap[i] << shift) | (next >> (8 - shift)));
+      }
+    }
+    return true;
+  }
+
+  CachedGlyph* AllocateGlyph(const Font& font, uint32_t glyphId) {
+    uint32_t size = BitmapSize(font, glyphId);
+    if (size == 0 || size > cacheSize) {
+      return nullptr;
+    }
+
+    CachedGlyph* freeEntry;
+    do {
+      freeEntry = nullptr;
+      CachedGlyph* oldest = nullptr;
+      for (auto& entry : cachedGlyphs) {
+        if (entry.bitmap == nullptr) {
+          freeEntry = &entry;
+        } else if (oldest == nullptr || entry.lastUse < oldest->lastUse) {
+          oldest = &entry;
+        }
+      }
+      if (freeEntry != nullptr && cacheUsed + size <= cacheSize) {
+        break;
+      }
+      Evict(*oldest);
+    } while (true);
+
+    freeEntry->bitmap = static_cast<uint8_t*>(lv_mem_alloc(size));
+    if (freeEntry->bitmap == nullptr) {
+      return nullptr;
+    }
+    freeEntry->font = &font;
+    freeEntry->glyphId = glyphId;
+    freeEntry->size = size;
+    freeEntry->lastUse = ++useCounter;
+    cacheUsed += size;
+    return freeEntry;
+  }
+
+  CachedGlyph* FindGlyph(const Font& font, uint32_t glyphId) {
+    for (auto& entry : cachedGlyphs) {
+      if (entry.font == &font && entry.glyphId == glyphId) {
+        entry.lastUse = ++useCounter;
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  CachedGlyph* LoadGlyph(const Font& font, FileReader& reader, uint32_t glyphId) {
+    CachedGlyph* entry = AllocateGlyph(font, glyphId);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+    if (!ReadBitmap(font, reader, glyphId, entry->bitmap)) {
+      Evict(*entry);
+      return nullptr;
+    }
+    return entry;
+  }
+
+  const uint8_t* GetGlyphBitmap(const lv_font_t* lvFont, uint32_t letter) {
+    const auto& font = *reinterpret_cast<const Font*>(lvFont);
+    uint32_t glyphId = GlyphId(font.dsc, letter);
+    if (glyphId == 0 || glyphId >= font.glyphCount) {
+      return nullptr;
+    }
+
+    CachedGlyph* entry = FindGlyph(font, glyphId);
+    if (entry == nullptr) {
+      Pinetime::Controllers::ResourceStore::File file;
+      if (font.resources->Open(&file, font.path) != LFS_ERR_OK) {
+        return nullptr;
+      }
+      FileReader reader {*font.resources, file};
+      entry = LoadGlyph(font, reader, glyphId);
+      font.resources->Close(&file);
+    }
+    return (entry != nullptr) ? entry->bitmap : nullptr;
+  }
+
+  bool LoadCmaps(FileReader& reader, lv_font_fmt_txt_dsc_t& dsc, uint32_t start) {
+    uint32_t count;
+    if (reader.ReadLabel(start, "cmap") < 0 || !reader.Read(count) || count == 0) {
+      return false;
+    }
+
+    auto* cmaps = static_cast<lv_font_fmt_txt_cmap_t*>(lv_mem_alloc(count * sizeof(lv_font_fmt_txt_cmap_t)));
+    if (cmaps == nullptr) {
+      return false;
+    }
+    std::memset(cmaps, 0, count * sizeof(lv_font_fmt_txt_cmap_t));
+    dsc.cmaps = cmaps;
+    dsc.cmap_num = count;
+
+    for (uint32_t i = 0; i < count; i++) {
+      CmapTable table;
+      if (!reader.Seek(start + 12 + i * sizeof(CmapTable)) || !reader.Read(table)) {
+        return false;
+      }
+      lv_font_fmt_txt_cmap_t& cmap = cmaps[i];
+      cmap.range_start = table.rangeStart;
+      cmap.range_length = table.rangeLength;
+      cmap.glyph_id_start = table.glyphIdStart;
+      cmap.type = static_cast<lv_font_fmt_txt_cmap_type_t>(table.formatType);
+
+      if (!reader.Seek(start + table.dataOffset)) {
+        return false;
+      }
+      switch (cmap.type) {
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL: {
+          auto* ids = static_cast<uint8_t*>(lv_mem_alloc(table.dataEntriesCount));
+          cmap.glyph_id_ofs_list = ids;
+          cmap.list_length = cmap.range_length;
+          if (ids == nullptr || !reader.Read(ids, table.dataEntriesCount)) {
+            return false;
+          }
+        } break;
+        case LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY:
+          break;
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_FULL:
+        case LV_FONT_FMT_TXT_CMAP_SPARSE_TINY: {
+          uint32_t listSize = table.dataEntriesCount * sizeof(uint16_t);
+          auto* unicodeList = static_cast<uint16_t*>(lv_mem_alloc(listSize));
+          cmap.unicode_list = unicodeList;
+          cmap.list_length = table.dataEntriesCount;
+          if (unicodeList == nullptr || !reader.Read(unicodeList, listSize)) {
+            return false;
+          }
+          if (cmap.type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            auto* ids = static_cast<uint16_t*>(lv_mem_alloc(listSize));
+            cmap.glyph_id_ofs_list = ids;
+            if (ids == nullptr || !reader.Read(ids, listSize)) {
+              return false;
+            }
+          }
+        } break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  bool LoadGlyphMetrics(FileReader& reader, Font& font, const FontHeader& header) {
+    auto* glyphs = static_cast<lv_font_fmt_txt_glyph_dsc_t*>(lv_mem_alloc(font.glyphCount * sizeof(lv_font_fmt_txt_glyph_dsc_t)));
+    if (glyphs == nullptr) {
+      return false;
+    }
+    std::memset(glyphs, 0, font.glyphCount * sizeof(lv_font_fmt_txt_glyph_dsc_t));
+    font.dsc.glyph_dsc = glyphs;
+
+    font.glyphHeaderBits = header.advanceWidthBits + 2 * header.xyBits + 2 * header.whBits;
+    // Glyph 0 is reserved
+    for (uint32_t i = 1; i < font.glyphCount; i++) {
+      uint8_t metrics[8] = {};
+      uint32_t available = font.glyphOffsets[i + 1] - font.glyphOffsets[i];
+      uint32_t size = std::min<uint32_t>((font.glyphHeaderBits + 7) / 8, std::min<uint32_t>(available, sizeof(metrics)));
+      if (!reader.Seek(font.glyphTableStart + font.glyphOffsets[i]) || !reader.Read(metrics, size)) {
+        return false;
+      }
+
+      BitReader bits {metrics};
+      lv_font_fmt_txt_glyph_dsc_t& glyph = glyphs[i];
+      uint32_t advanceWidth = (header.advanceWidthBits == 0) ? header.defaultAdvanceWidth : bits.Read(header.advanceWidthBits);
+      if (header.advanceWidthFormat == 0) {
+        advanceWidth *= 16;
+      }
+      glyph.adv_w = advanceWidth;
+      glyph.ofs_x = bits.ReadSigned(header.xyBits);
+      glyph.ofs_y = bits.ReadSigned(header.xyBits);
+      glyph.box_w = bits.Read(header.whBits);
+      glyph.box_h = bits.Read(header.whBits);
+      // Bitmaps are not in RAM: LVGL only passes the glyph metrics around, the bitmap comes from GetGlyphBitmap()
+      glyph.bitmap_index = 0;
+    }
+    return true;
+  }
+
+  bool LoadKerning(FileReader& reader, lv_font_fmt_txt_dsc_t& dsc, uint8_t glyphIdFormat, uint32_t start) {
+    uint8_t format;
+    uint8_t padding[3];
+    if (reader.ReadLabel(start, "kern") < 0 || !reader.Read(format) || !reader.Read(padding, sizeof(padding))) {
+      return false;
+    }
+
+    if (format == 0) {
+      // Sorted pairs of glyph ids
+      auto* pairs = static_cast<lv_font_fmt_txt_kern_pair_t*>(lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_pair_t)));
+      if (pairs == nullptr) {
+        return false;
+      }
+      std::memset(pairs, 0, sizeof(lv_font_fmt_txt_kern_pair_t));
+      dsc.kern_dsc = pairs;
+      dsc.kern_classes = 0;
+
+      uint32_t count;
+      if (!reader.Read(count)) {
+        return false;
+      }
+      uint32_t idsSize = count * 2 * ((glyphIdFormat == 0) ? sizeof(uint8_t) : sizeof(uint16_t));
+      auto* ids = static_cast<uint8_t*>(lv_mem_alloc(idsSize));
+      auto* values = static_cast<int8_t*>(lv_mem_alloc(count));
+      pairs->glyph_ids = ids;
+      pairs->values = values;
+      pairs->glyph_ids_size = glyphIdFormat;
+      pairs->pair_cnt = count;
+      return ids != nullptr && values != nullptr && reader.Read(ids, idsSize) && reader.Read(values, count);
+    }
+
+    if (format == 3) {
+      // Table of classes
+      auto* classes = static_cast<lv_font_fmt_txt_kern_classes_t*>(lv_mem_alloc(sizeof(lv_font_fmt_txt_kern_classes_t)));
+      if (classes == nullptr) {
+        return false;
+      }
+      std::memset(classes, 0, sizeof(lv_font_fmt_txt_kern_classes_t));
+      dsc.kern_dsc = classes;
+      dsc.kern_classes = 1;
+
+      uint16_t mappingLength;
+      uint8_t rows;
+      uint8_t columns;
+      if (!reader.Read(mappingLength) || !reader.Read(rows) || !reader.Read(columns)) {
+        return false;
+      }
+      auto* left = static_cast<uint8_t*>(lv_mem_alloc(mappingLength));
+      auto* right = static_cast<uint8_t*>(lv_mem_alloc(mappingLength));
+      auto* values = static_cast<int8_t*>(lv_mem_alloc(rows * columns));
+      classes->left_class_mapping = left;
+      classes->right_class_mapping = right;
+      classes->class_pair_values = values;
+      classes->left_class_cnt = rows;
+      classes->right_class_cnt = columns;
+      return left != nullptr && right != nullptr && values != nullptr && reader.Read(left, mappingLength) &&
+             reader.Read(right, mappingLength) && reader.Read(values, rows * columns);
+    }
+
+    return false;
+  }
+
+  void FreeKerning(const lv_font_fmt_txt_dsc_t& dsc) {
+    if (dsc.kern_dsc == nullptr) {
+      return;
+    }
+    if (dsc.kern_classes == 0) {
+      auto* pairs = static_cast<lv_font_fmt_txt_kern_pair_t*>(const_cast<void*>(dsc.kern_dsc));
+      lv_mem_free(const_cast<void*>(pairs->glyph_ids));
+      lv_mem_free(const_cast<int8_t*>(pairs->values));
+      lv_mem_free(pairs);
+    } else {
+      auto* classes = static_cast<lv_font_fmt_txt_kern_classes_t*>(const_cast<void*>(dsc.kern_dsc));
+      lv_mem_free(const_cast<uint8_t*>(classes->left_class_mapping));
+      lv_mem_free(const_cast<uint8_t*>(classes->right_class_mapping));
+      lv_mem_free(const_cast<int8_t*>(classes->class_pair_values));
+      lv_mem_free(classes);
+    }
+  }
+
+  bool LoadFont(FileReader& reader, Font& font) {
+    FontHeader header;
+    int32_t headerLength = reader.ReadLabel(0, "head");
+    if (headerLength < 0 || !reader.Read(header)) {
+      return false;
+    }
+    // Compressed bitmaps would need LVGL's decompressor, which is not exported
+    if (header.compressionId != 0) {
+      return false;
+    }
+
+    font.font.base_line = -header.descent;
+    font.font.line_height = header.ascent - header.descent;
+    font.font.subpx = header.subpixelsMode;
+    font.font.get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+    font.font.get_glyph_bitmap = GetGlyphBitmap;
+    font.font.dsc = &font.dsc;
+    font.dsc.bpp = header.bitsPerPixel;
+    font.dsc.kern_scale = header.kerningScale;
+    font.dsc.bitmap_format = header.compressionId;
+
+    uint32_t cmapsStart = headerLength;
+    int32_t cmapsLength = reader.ReadLabel(cmapsStart, "cmap");
+    if (cmapsLength < 0 || !LoadCmaps(reader, font.dsc, cmapsStart)) {
+      return false;
+    }
+
+    uint32_t locaStart = cmapsStart + cmapsLength;
+    int32_t locaLength = reader.ReadLabel(locaStart, "loca");
+    uint32_t glyphCount;
+    if (locaLength < 0 || !reader.Read(glyphCount) || glyphCount == 0) {
+      return false;
+    }
+    font.glyphOffsets = static_cast<uint32_t*>(lv_mem_alloc((glyphCount + 1) * sizeof(uint32_t)));
+    if (font.glyphOffsets == nullptr) {
+      return false;
+    }
+    font.glyphCount = glyphCount;
+    for (uint32_t i = 0; i < glyphCount; i++) {
+      if (header.indexToLocFormat == 0) {
+        uint16_t offset;
+        if (!reader.Read(offset)) {
+          return false;
+        }
+        font.glyphOffsets[i] = offset;
+      } else if (!reader.Read(font.glyphOffsets[i])) {
+        return false;
+      }
+    }
+
+    font.glyphTableStart = locaStart + locaLength;
+    int32_t glyphTableLength = reader.ReadLabel(font.glyphTableStart, "glyf");
+    if (glyphTableLength < 0) {
+      return false;
+    }
+    font.glyphOffsets[glyphCount] = glyphTableLength;
+    if (!LoadGlyphMetrics(reader, font, header)) {
+      return false;
+    }
+
+    if (header.tablesCount >= 4) {
+      return LoadKerning(reader, font.dsc, header.glyphIdFormat, font.glyphTableStart + glyphTableLength);
+    }
+    return true;
+  }
+}
+
+lv_font_t* ExternalFont::Load(Pinetime::Controllers::FS& fs, const char* path) {
+  if (std::strlen(path) >= sizeof(Font::path)) {
+    return nullptr;
+  }
+  Pinetime::Controllers::ResourceStore& resources = fs.Resources();
+  Pinetime::Controllers::ResourceStore::File file;
+  if (resources.Open(&file, path) != LFS_ERR_OK) {
+    return nullptr;
+  }
+
+  auto* font = static_cast<Font*>(lv_mem_alloc(sizeof(Font)));
+  if (font == nullptr) {
+    resources.Close(&file);
+    return nullptr;
+  }
+  std::memset(font, 0, sizeof(Font));
+  font->resources = &resources;
+  std::strcpy(font->path, path);
+
+  FileReader reader {resources, file};
+  bool loaded = LoadFont(reader, *font);
+  resources.Close(&file);
+  if (!loaded) {
+    Free(&font->font);
+    return nullptr;
+  }
+  return &font->font;
+}
+
+void ExternalFont::Free(lv_font_t* lvFont) {
+  if (lvFont == nullptr) {
+    return;
+  }
+  auto* font = reinterpret_cast<Font*>(lvFont);
+  for (auto& entry : cachedGlyphs) {
+    if (entry.font == font) {
+      Evict(entry);
+    }
+  }
+
+  FreeKerning(font->dsc);
+  if (font->dsc.cmaps != nullptr) {
+    for (uint16_t i = 0; i < font->dsc.cmap_num; i++) {
+      lv_mem_free(const_cast<void*>(font->dsc.cmaps[i].glyph_id_ofs_list));
+      lv_mem_free(const_cast<uint16_t*>(font->dsc.cmaps[i].unicode_list));
+    }
+    lv_mem_free(const_cast<lv_font_fmt_txt_cmap_t*>(font->dsc.cmaps));
+  }
+  lv_mem_free(const_cast<lv_font_fmt_txt_glyph_dsc_t*>(font->dsc.glyph_dsc));
+  lv_mem_free(font->glyphOffsets);
+  lv_mem_free(font);
+}
+
+void ExternalFont::Prefetch(lv_font_t* lvFont, const char* characters) {
+  if (lvFont == nullptr) {
+    return;
+  }
+  const auto& font = *reinterpret_cast<const Font*>(lvFont);
+  Pinetime::Controllers::ResourceStore::File file;
+  if (font.resources->Open(&file, font.path) != LFS_ERR_OK) {
+    return;
+  }
+
+  FileReader reader {*font.resources, file};
+  uint32_t index = 0;
+  while (characters[index] != '\0') {
+    uint32_t glyphId = GlyphId(font.dsc, _lv_txt_encoded_next(characters, &index));
+    if (glyphId == 0 || glyphId >= font.glyphCount || FindGlyph(font, glyphId) != nullptr) {
+      continue;
+    }
+    // Only use free space: evicting glyphs (possibly the ones just prefetched) to make room would defeat the purpose
+    bool hasFreeEntry = std::any_of(std::begin(cachedGlyphs), std::end(cachedGlyphs), [](const CachedGlyph& entry) {
+      return entry.bitmap == nullptr;
+    });
+    if (hasFreeEntry && cacheUsed + BitmapSize(font, glyphId) <= cacheSize) {
+      LoadGlyph(font, reader, glyphId);
+    }
+  }
+  font.resources->Close(&file);
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <lvgl/lvgl.h>
+
+// Glyph bitmaps kept in RAM for all the external fonts, in bytes. Set with -DEXTERNAL_FONT_CACHE_SIZE=n.
+#ifndef EXTERNAL_FONT_CACHE_SIZE
+  #define EXTERNAL_FONT_CACHE_SIZE 8192
+#endif
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Components {
+    // Fonts in the LVGL binary format (lv_font_conv --format bin), stored in the file system.
+    // Unlike lv_font_load(), only the header, the character map, the glyph metrics and the kerning table are
+    // loaded when the font is opened. Glyph bitmaps are read from the file when LVGL draws them, and kept in a
+    // cache shared by all the external fonts, with least recently used eviction.
+    namespace ExternalFont {
+      // Returns nullptr if the file doesn't exist or is not a valid font
+      lv_font_t* Load(Pinetime::Controllers::FS& fs, const char* path);
+      void Free(lv_font_t* font);
+
+      // Loads the bitmaps of the given characters (UTF-8), so that the first frame doesn't read them one by one.
+      // Characters that don't fit in the free space of the cache are skipped, nothing is evicted
+      void Prefetch(lv_font_t* font, const char* characters);
+    }
+  }
+}
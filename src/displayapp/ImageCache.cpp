@@ -0,0 +1,282 @@
+#include "displayapp/ImageCache.h"
+#include <algorithm>
+#include <cstring>
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Components;
+
+namespace {
+  // Image sources of the F: drive, without the drive letter
+  const char* FilePath(const void* src) {
+    if (lv_img_src_get_type(src) != LV_IMG_SRC_FILE) {
+      return nullptr;
+    }
+    const char* path = static_cast<const char*>(src);
+    if (path[0] != 'F' || path[1] != ':') {
+      return nullptr;
+    }
+    return path + 2;
+  }
+
+  bool IsTrueColor(uint8_t colorFormat) {
+    return colorFormat == LV_IMG_CF_TRUE_COLOR || colorFormat == LV_IMG_CF_TRUE_COLOR_ALPHA ||
+           colorFormat == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+  }
+
+  bool IsIndexed(uint8_t colorFormat) {
+    return colorFormat >= LV_IMG_CF_INDEXED_1BIT && colorFormat <= LV_IMG_CF_INDEXED_8BIT;
+  }
+}
+
+ImageCache::ImageCache(Pinetime::Controllers::FS& filesystem) : filesystem {filesystem} {
+}
+
+void ImageCache::Init() {
+  // Decoders are tried from the last one created, the built-in decoder still handles the other images
+  lv_img_decoder_t* decoder = lv_img_decoder_create();
+  lv_img_decoder_set_info_cb(decoder, Info);
+  lv_img_decoder_set_open_cb(decoder, Open);
+  lv_img_decoder_set_read_line_cb(decoder, ReadLine);
+  lv_img_decoder_set_close_cb(decoder, Close);
+  decoder->user_data = this;
+}
+
+lv_res_t ImageCache::Info(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+  auto* cache = static_cast<ImageCache*>(decoder->user_data);
+  const char* path = FilePath(src);
+  if (path == nullptr || std::strlen(path) >= maxPathLength || !cache->ReadHeader(path, *header)) {
+    return LV_RES_INV;
+  }
+  return (IsTrueColor(header->cf) || IsIndexed(header->cf)) ? LV_RES_OK : LV_RES_INV;
+}
+
+lv_res_t ImageCache::Open(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+  auto* cache = static_cast<ImageCache*>(decoder->user_data);
+  const char* path = FilePath(dsc->src);
+  if (path == nullptr) {
+    return LV_RES_INV;
+  }
+
+  auto* image = static_cast<OpenImage*>(lv_mem_alloc(sizeof(OpenImage)));
+  if (image == nullptr) {
+    return LV_RES_INV;
+  }
+  std::memset(image, 0, sizeof(OpenImage));
+  std::strcpy(image->path, path);
+  dsc->user_data = image;
+
+  uint8_t bitsPerPixel = lv_img_cf_get_px_size(dsc->header.cf);
+  image->stride = (dsc->header.w * bitsPerPixel + 7) / 8;
+  image->dataOffset = sizeof(lv_img_header_t);
+  if (IsIndexed(dsc->header.cf)) {
+    image->dataOffset += (1U << bitsPerPixel) * sizeof(lv_color32_t);
+    if (!cache->LoadPalette(*image, bitsPerPixel)) {
+      Close(decoder, dsc);
+      return LV_RES_INV;
+    }
+    return LV_RES_OK;
+  }
+
+  uint32_t size = image->stride * dsc->header.h;
+  if (size > maxPinnedSize) {
+    return LV_RES_OK;
+  }
+
+  Entry* entry = cache->Find(path, true, 0);
+  if (entry != nullptr) {
+    cache->statistics.hits++;
+  } else {
+    cache->statistics.misses++;
+    if (cache->PinnedSize() + size > maxPinnedSize) {
+      // Drawn line by line instead
+      return LV_RES_OK;
+    }
+    entry = cache->Allocate(size);
+    if (entry == nullptr) {
+      return LV_RES_OK;
+    }
+    if (!cache->ReadFile(path, image->dataOffset, entry->data, size)) {
+      cache->Evict(*entry);
+      Close(decoder, dsc);
+      return LV_RES_INV;
+    }
+    std::strcpy(entry->path, path);
+    entry->whole = true;
+    entry->nbRows = dsc->header.h;
+  }
+
+  entry->users++;
+  image->whole = entry;
+  dsc->img_data = entry->data;
+  return LV_RES_OK;
+}
+
+lv_res_t ImageCache::ReadLine(lv_img_decoder_t* decoder,
+                              lv_img_decoder_dsc_t* dsc,
+                              lv_coord_t x,
+                              lv_coord_t y,
+                              lv_coord_t len,
+                              uint8_t* buf) {
+  auto* cache = static_cast<ImageCache*>(decoder->user_data);
+  auto* image = static_cast<OpenImage*>(dsc->user_data);
+
+  Entry* entry = cache->Find(image->path, false, y);
+  if (entry != nullptr) {
+    cache->statistics.hits++;
+  } else {
+    cache->statistics.misses++;
+    uint16_t rowsPerBand = std::max<uint32_t>(1, bandSize / image->stride);
+    uint16_t firstRow = y - (y % rowsPerBand);
+    uint16_t nbRows = std::min<uint16_t>(rowsPerBand, dsc->header.h - firstRow);
+    uint32_t size = nbRows * image->stride;
+    entry = cache->Allocate(size);
+    if (entry == nullptr) {
+      return LV_RES_INV;
+    }
+    if (!cache->ReadFile(image->path, image->dataOffset + firstRow * image->stride, entry->data, size)) {
+      cache->Evict(*entry);
+      return LV_RES_INV;
+    }
+    std::strcpy(entry->path, image->path);
+    entry->firstRow = firstRow;
+    entry->nbRows = nbRows;
+  }
+
+  const uint8_t* row = entry->data + (y - entry->firstRow) * image->stride;
+  uint8_t bitsPerPixel = lv_img_cf_get_px_size(dsc->header.cf);
+  if (image->palette == nullptr) {
+    std::memcpy(buf, row + x * bitsPerPixel / 8, len * bitsPerPixel / 8);
+    return LV_RES_OK;
+  }
+
+  // Same output as the built-in decoder: the color and the opacity of each pixel
+  const uint8_t mask = (1U << bitsPerPixel) - 1;
+  uint32_t bit = x * bitsPerPixel;
+  for (lv_coord_t i = 0; i < len; i++, bit += bitsPerPixel) {
+    uint8_t index = (row[bit / 8] >> (8 - bitsPerPixel - (bit % 8))) & mask;
+    lv_color_t color = image->palette[index];
+    buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full & 0xFF;
+    buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 1] = (color.full >> 8) & 0xFF;
+    buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = image->opa[index];
+  }
+  return LV_RES_OK;
+}
+
+void ImageCache::Close(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* dsc) {
+  auto* image = static_cast<OpenImage*>(dsc->user_data);
+  if (image == nullptr) {
+    return;
+  }
+  if (image->whole != nullptr) {
+    image->whole->users--;
+  }
+  lv_mem_free(image->palette);
+  lv_mem_free(image->opa);
+  lv_mem_free(image);
+  dsc->user_data = nullptr;
+  dsc->img_data = nullptr;
+}
+
+bool ImageCache::ReadHeader(const char* path, lv_img_header_t& header) {
+  return ReadFile(path, 0, &header, sizeof(lv_img_header_t));
+}
+
+bool ImageCache::ReadFile(const char* path, uint32_t offset, void* buffer, uint32_t size) {
+  Pinetime::Controllers::ResourceStore& resources = filesystem.Resources();
+  Pinetime::Controllers::ResourceStore::File file;
+  if (resources.Open(&file, path) != LFS_ERR_OK) {
+    return false;
+  }
+  bool result = resources.Seek(&file, offset) >= 0 && resources.Read(&file, static_cast<uint8_t*>(buffer), size) == static_cast<int>(size);
+  resources.Close(&file);
+  return result;
+}
+
+bool ImageCache::LoadPalette(OpenImage& image, uint8_t bitsPerPixel) {
+  uint32_t paletteSize = 1U << bitsPerPixel;
+  image.palette = static_cast<lv_color_t*>(lv_mem_alloc(paletteSize * sizeof(lv_color_t)));
+  image.opa = static_cast<lv_opa_t*>(lv_mem_alloc(paletteSize * sizeof(lv_opa_t)));
+  if (image.palette == nullptr || image.opa == nullptr) {
+    return false;
+  }
+
+  lv_color32_t colors[16];
+  for (uint32_t first = 0; first < paletteSize; first += 16) {
+    uint32_t count = std::min<uint32_t>(16, paletteSize - first);
+    if (!ReadFile(image.path, sizeof(lv_img_header_t) + first * sizeof(lv_color32_t), colors, count * sizeof(lv_color32_t))) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      image.palette[first + i] = lv_color_make(colors[i].ch.red, colors[i].ch.green, colors[i].ch.blue);
+      image.opa[first + i] = colors[i].ch.alpha;
+    }
+  }
+  return true;
+}
+
+ImageCache::Entry* ImageCache::Find(const char* path, bool whole, uint16_t row) {
+  uint32_t generation = filesystem.GetModificationCount();
+  for (auto& entry : entries) {
+    if (entry.data == nullptr || entry.generation != generation || entry.whole != whole) {
+      continue;
+    }
+    if (std::strcmp(entry.path, path) == 0 && row >= entry.firstRow && row < entry.firstRow + entry.nbRows) {
+      entry.lastUse = ++useCounter;
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+ImageCache::Entry* ImageCache::Allocate(uint32_t size) {
+  uint32_t generation = filesystem.GetModificationCount();
+  // The files were modified since these entries were loaded
+  for (auto& entry : entries) {
+    if (entry.data != nullptr && entry.users == 0 && entry.generation != generation) {
+      Evict(entry);
+    }
+  }
+
+  while (true) {
+    Entry* freeEntry = nullptr;
+    Entry* oldest = nullptr;
+    for (auto& entry : entries) {
+      if (entry.data == nullptr) {
+        freeEntry = &entry;
+      } else if (entry.users == 0 && (oldest == nullptr || entry.lastUse < oldest->lastUse)) {
+        oldest = &entry;
+      }
+    }
+    if (freeEntry != nullptr && statistics.used + size <= cacheSize) {
+      freeEntry->data = static_cast<uint8_t*>(lv_mem_alloc(size));
+      if (freeEntry->data == nullptr) {
+        return nullptr;
+      }
+      freeEntry->size = size;
+      freeEntry->generation = generation;
+      freeEntry->lastUse = ++useCounter;
+      statistics.used += size;
+      return freeEntry;
+    }
+    if (oldest == nullptr) {
+      return nullptr;
+    }
+    Evict(*oldest);
+  }
+}
+
+void ImageCache::Evict(Entry& entry) {
+  lv_mem_free(entry.data);
+  statistics.used -= entry.size;
+  entry = {};
+}
+
+uint32_t ImageCache::PinnedSize() const {
+  uint32_t size = 0;
+  for (const auto& entry : entries) {
+    if (entry.data != nullptr && entry.users > 0) {
+      size += entry.size;
+    }
+  }
+  return size;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <lvgl/lvgl.h>
+
+// RAM used by the pixels of the images loaded from the file system, in bytes. Set with -DIMAGE_CACHE_SIZE=n.
+#ifndef IMAGE_CACHE_SIZE
+  #define IMAGE_CACHE_SIZE 6144
+#endif
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Components {
+    // LVGL image decoder for the images of the F: drive (true color and indexed formats).
+    // The built-in decoder reads the lines of these images from the file every time they are drawn. This one keeps
+    // their pixels in RAM with least recently used eviction, so static images are read from the flash only once:
+    //  - small true color images are loaded whole, and LVGL draws them straight from the cache;
+    //  - other images are loaded by bands of rows, only the rows that are drawn are read.
+    // The cache is dropped as soon as a file is modified in the file system.
+    class ImageCache {
+    public:
+      struct Statistics {
+        // Images opened by LVGL, and lines drawn, served from the cache or read from the file
+        uint32_t hits = 0;
+        uint32_t misses = 0;
+        // Bytes of pixels held in the cache
+        uint32_t used = 0;
+      };
+
+      explicit ImageCache(Pinetime::Controllers::FS& filesystem);
+
+      ImageCache(const ImageCache&) = delete;
+      ImageCache& operator=(const ImageCache&) = delete;
+
+      // Registers the decoder, after lv_init()
+      void Init();
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+    private:
+      static constexpr size_t cacheSize = IMAGE_CACHE_SIZE;
+      // Whole images are pinned while LVGL keeps them open: at most half of the cache, the rest is for bands
+      static constexpr size_t maxPinnedSize = cacheSize / 2;
+      static constexpr size_t bandSize = 512;
+      static constexpr size_t maxEntries = 16;
+      static constexpr size_t maxPathLength = 40;
+
+      struct Entry {
+        char path[maxPathLength] = {};
+        uint32_t generation = 0;
+        // Rows of the image held by this entry, all of them for a whole image
+        uint16_t firstRow = 0;
+        uint16_t nbRows = 0;
+        bool whole = false;
+        // Number of images opened by LVGL that point to the data
+        uint8_t users = 0;
+        uint32_t lastUse = 0;
+        uint32_t size = 0;
+        uint8_t* data = nullptr;
+      };
+
+      // Image opened by LVGL
+      struct OpenImage {
+        char path[maxPathLength];
+        uint32_t dataOffset;
+        uint32_t stride;
+        Entry* whole;
+        // Colors of indexed images
+        lv_color_t* palette;
+        lv_opa_t* opa;
+      };
+
+      static lv_res_t Info(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header);
+      static lv_res_t Open(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc);
+      static lv_res_t ReadLine(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+      static void Close(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc);
+
+      bool ReadHeader(const char* path, lv_img_header_t& header);
+      bool ReadFile(const char* path, uint32_t offset, void* buffer, uint32_t size);
+      bool LoadPalette(OpenImage& image, uint8_t bitsPerPixel);
+      Entry* Find(const char* path, bool whole, uint16_t row);
+      Entry* Allocate(uint32_t size);
+      void Evict(Entry& entry);
+      uint32_t PinnedSize() const;
+
+      Pinetime::Controllers::FS& filesystem;
+      Entry entries[maxEntries];
+      uint32_t useCounter = 0;
+      Statistics statistics;
+    };
+  }
+}
@@ -3,9 +3,13 @@
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <algorithm>
+#include <cstdlib>
 #include "drivers/St7789.h"
 #include "littlefs/lfs.h"
 #include "components/fs/FS.h"
+#include "utility/ColorPacking.h"
+#include "utility/ColorBlending.h"
 
 using namespace Pinetime::Components;
 
@@ -16,39 +20,44 @@ namespace {
   }
 
   lv_fs_res_t lvglOpen(lv_fs_drv_t* drv, void* file_p, const char* path, lv_fs_mode_t /*mode*/) {
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    int res = filesys->FileOpen(file, path, LFS_O_RDONLY);
+    auto* file = static_cast<Pinetime::Controllers::ResourceStore::File*>(file_p);
+    auto* resources = static_cast<Pinetime::Controllers::ResourceStore*>(drv->user_data);
+    int res = resources->Open(file, path);
     if (res == 0) {
-      if (file->type == 0) {
-        return LV_FS_RES_FS_ERR;
-      } else {
-        return LV_FS_RES_OK;
-      }
+      return LV_FS_RES_OK;
+    }
+    if (res == LFS_ERR_ISDIR) {
+      return LV_FS_RES_FS_ERR;
     }
     return LV_FS_RES_NOT_EX;
   }
 
   lv_fs_res_t lvglClose(lv_fs_drv_t* drv, void* file_p) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileClose(file);
+    auto* resources = static_cast<Pinetime::Controllers::ResourceStore*>(drv->user_data);
+    auto* file = static_cast<Pinetime::Controllers::ResourceStore::File*>(file_p);
+    resources->Close(file);
 
     return LV_FS_RES_OK;
   }
 
   lv_fs_res_t lvglRead(lv_fs_drv_t* drv, void* file_p, void* buf, uint32_t btr, uint32_t* br) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileRead(file, static_cast<uint8_t*>(buf), btr);
-    *br = btr;
+    auto* resources = static_cast<Pinetime::Controllers::ResourceStore*>(drv->user_data);
+    auto* file = static_cast<Pinetime::Controllers::ResourceStore::File*>(file_p);
+    int result = resources->Read(file, static_cast<uint8_t*>(buf), btr);
+    if (result < 0) {
+      *br = 0;
+      return LV_FS_RES_HW_ERR;
+    }
+    *br = static_cast<uint32_t>(result);
     return LV_FS_RES_OK;
   }
 
   lv_fs_res_t lvglSeek(lv_fs_drv_t* drv, void* file_p, uint32_t pos) {
-    Pinetime::Controllers::FS* filesys = static_cast<Pinetime::Controllers::FS*>(drv->user_data);
-    lfs_file_t* file = static_cast<lfs_file_t*>(file_p);
-    filesys->FileSeek(file, pos);
+    auto* resources = static_cast<Pinetime::Controllers::ResourceStore*>(drv->user_data);
+    auto* file = static_cast<Pinetime::Controllers::ResourceStore::File*>(file_p);
+    if (resources->Seek(file, pos) < 0) {
+      return LV_FS_RES_HW_ERR;
+    }
     return LV_FS_RES_OK;
   }
 }
@@ -58,6 +67,46 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
   lvgl->FlushDisplay(area, color_p);
 }
 
+static void disp_wait(lv_disp_drv_t* disp_drv) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->WaitForFlush();
+}
+
+static void refr_task(lv_task_t* task) {
+  auto* disp = static_cast<lv_disp_t*>(task->user_data);
+  auto* lvgl = static_cast<LittleVgl*>(disp->driver.user_data);
+  lvgl->PlanFlushes(disp);
+  _lv_disp_refr_task(task);
+}
+
+static void monitor(lv_disp_drv_t* disp_drv, uint32_t time, uint32_t /*px*/) {
+  auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
+  lvgl->OnRefreshDone(time);
+}
+
+static void gpu_fill(lv_disp_drv_t* /*disp_drv*/,
+                     lv_color_t* dest_buf,
+                     lv_coord_t dest_width,
+                     const lv_area_t* fill_area,
+                     lv_color_t color) {
+  // fill_area is relative to dest_buf, which is dest_width pixels wide
+  const auto width = static_cast<size_t>(lv_area_get_width(fill_area));
+  auto* line = reinterpret_cast<uint16_t*>(dest_buf) + fill_area->y1 * dest_width + fill_area->x1;
+  for (lv_coord_t y = fill_area->y1; y <= fill_area->y2; y++) {
+    Pinetime::Utility::FillRgb565(line, width, color.full);
+    line += dest_width;
+  }
+}
+
+static void gpu_blend(lv_disp_drv_t* /*disp_drv*/, lv_color_t* dest, const lv_color_t* src, uint32_t length, lv_opa_t opa) {
+  // LVGL skips its own copy when this callback is set, so fully opaque maps must be copied here
+  if (opa > LV_OPA_MAX) {
+    std::copy_n(src, length, dest);
+    return;
+  }
+  Pinetime::Utility::BlendRgb565(reinterpret_cast<uint16_t*>(dest), reinterpret_cast<const uint16_t*>(src), length, opa);
+}
+
 static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
   if (lvgl->GetFullRefresh()) {
@@ -73,7 +122,7 @@ bool touchpad_read(lv_indev_drv_t* indev_drv, lv_indev_data_t* data) {
   return lvgl->GetTouchPadInfo(data);
 }
 
-LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem) : lcd {lcd}, filesystem {filesystem} {
+LittleVgl::LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem) : lcd {lcd}, filesystem {filesystem}, imageCache {filesystem} {
 }
 
 void LittleVgl::Init() {
@@ -82,9 +131,14 @@ void LittleVgl::Init() {
   InitDisplay();
   InitTouchpad();
   InitFileSystem();
+  imageCache.Init();
 }
 
 void LittleVgl::InitDisplay() {
+  if (flushDone == nullptr) {
+    flushDone = xSemaphoreCreateBinary();
+  }
+
   lv_disp_buf_init(&disp_buf_2, buf2_1, buf2_2, LV_HOR_RES_MAX * 4); /*Initialize the display buffer*/
   lv_disp_drv_init(&disp_drv);                                       /*Basic initialization*/
 
@@ -100,9 +154,17 @@ void LittleVgl::InitDisplay() {
   disp_drv.buffer = &disp_buf_2;
   disp_drv.user_data = this;
   disp_drv.rounder_cb = rounder;
+  /*Block the display task instead of spinning while a buffer is being sent*/
+  disp_drv.wait_cb = disp_wait;
+  disp_drv.monitor_cb = monitor;
+  /*Opaque fills and unmasked blends of large areas*/
+  disp_drv.gpu_fill_cb = gpu_fill;
+  disp_drv.gpu_blend_cb = gpu_blend;
 
   /*Finally register the driver*/
-  lv_disp_drv_register(&disp_drv);
+  lv_disp_t* disp = lv_disp_drv_register(&disp_drv);
+  /*Merge and order the invalidated areas before each refresh*/
+  lv_task_set_cb(disp->refr_task, refr_task);
 }
 
 void LittleVgl::InitTouchpad() {
@@ -119,14 +181,14 @@ void LittleVgl::InitFileSystem() {
   lv_fs_drv_t fs_drv;
   lv_fs_drv_init(&fs_drv);
 
-  fs_drv.file_size = sizeof(lfs_file_t);
+  fs_drv.file_size = sizeof(Pinetime::Controllers::ResourceStore::File);
   fs_drv.letter = 'F';
   fs_drv.open_cb = lvglOpen;
   fs_drv.close_cb = lvglClose;
   fs_drv.read_cb = lvglRead;
   fs_drv.seek_cb = lvglSeek;
 
-  fs_drv.user_data = &filesystem;
+  fs_drv.user_data = &filesystem.Resources();
 
   lv_fs_drv_register(&fs_drv);
 }
@@ -149,6 +211,207 @@ void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
   fullRefresh = true;
 }
 
+uint32_t LittleVgl::FlushCost(const lv_area_t& area) const {
+  // LVGL renders and flushes an area in as many parts as needed to fit in the draw buffer
+  uint32_t width = lv_area_get_width(&area);
+  uint32_t height = lv_area_get_height(&area);
+  uint32_t linesPerFlush = std::max<uint32_t>(1, (LV_HOR_RES_MAX * nbWriteLines) / width);
+  uint32_t flushes = (height + linesPerFlush - 1) / linesPerFlush;
+  return PixelDataSize(width * height) + flushes * (windowSetupBytes + flushOverheadBytes);
+}
+
+void LittleVgl::SetReducedColorDepth(bool reduced) {
+  // Waits for the transfer in progress, if any, so it's not sent in the wrong format
+  lcd.SetColorFormat(reduced ? Drivers::St7789::ColorFormat::Rgb444 : Drivers::St7789::ColorFormat::Rgb565);
+}
+
+void LittleVgl::ScrollContent(lv_obj_t* content, lv_coord_t delta) {
+  if (delta == 0) {
+    return;
+  }
+  lv_disp_t* disp = lv_disp_get_default();
+  // Let LVGL redraw everything when the display is already scrolling for a full refresh,
+  // or when there is nothing left to keep on screen
+  if (IsScrolling() || hasPartialArea || std::abs(delta + pendingScroll) >= visibleNbLines) {
+    lv_obj_set_y(content, lv_obj_get_y(content) + delta);
+    return;
+  }
+
+  uint16_t pendingAreas = disp->inv_p;
+  lv_obj_set_y(content, lv_obj_get_y(content) + delta);
+  if (disp->inv_p < pendingAreas) {
+    // LVGL ran out of invalidated areas and invalidated the whole screen
+    return;
+  }
+
+  // Drop the areas invalidated by the move: the display moves the pixels already drawn.
+  // The areas that were still to be drawn move with them
+  const lv_area_t screen {0, 0, LV_HOR_RES_MAX - 1, visibleNbLines - 1};
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < pendingAreas; i++) {
+    lv_area_t area = disp->inv_areas[i];
+    area.y1 += delta;
+    area.y2 += delta;
+    if (_lv_area_intersect(&area, &area, &screen)) {
+      disp->inv_areas[count] = area;
+      disp->inv_area_joined[count] = 0;
+      count++;
+    }
+  }
+  disp->inv_p = count;
+  pendingScroll += delta;
+
+  lv_area_t exposed = screen;
+  if (delta > 0) {
+    exposed.y2 = delta - 1;
+  } else {
+    exposed.y1 = visibleNbLines + delta;
+  }
+  _lv_inv_area(disp, &exposed);
+}
+
+void LittleVgl::ApplyPendingScroll() {
+  if (pendingScroll == 0) {
+    return;
+  }
+  // Screen line y is written to frame memory line y + writeOffset, and displayed when the scroll start address
+  // is the same offset: moving the content by pendingScroll lines moves both offsets the other way
+  int32_t offset = (static_cast<int32_t>(writeOffset) - pendingScroll) % totalNbLines;
+  if (offset < 0) {
+    offset += totalNbLines;
+  }
+  writeOffset = static_cast<uint16_t>(offset);
+  scrollOffset = writeOffset;
+  pendingScroll = 0;
+  lcd.VerticalScrollStartAddress(scrollOffset);
+}
+
+void LittleVgl::SetPartialArea(uint16_t firstLine, uint16_t lastLine) {
+  firstLine = std::min<uint16_t>(firstLine, visibleNbLines - 1);
+  lastLine = std::clamp<uint16_t>(lastLine, firstLine, visibleNbLines - 1);
+  if (firstLine == 0 && lastLine == visibleNbLines - 1) {
+    ClearPartialArea();
+    return;
+  }
+
+  partialArea.x1 = 0;
+  partialArea.y1 = firstLine;
+  partialArea.x2 = LV_HOR_RES_MAX - 1;
+  partialArea.y2 = lastLine;
+  hasPartialArea = true;
+  // The partial area is set in frame memory lines, which are offset by the vertical scrolling
+  lcd.PartialModeOn((firstLine + writeOffset) % totalNbLines, (lastLine + writeOffset) % totalNbLines);
+}
+
+void LittleVgl::ClearPartialArea() {
+  if (!hasPartialArea) {
+    return;
+  }
+  hasPartialArea = false;
+  lcd.PartialModeOff();
+  lv_obj_invalidate(lv_scr_act());
+}
+
+uint32_t LittleVgl::PixelDataSize(uint32_t pixelCount) const {
+  if (lcd.GetColorFormat() == Drivers::St7789::ColorFormat::Rgb444) {
+    return (pixelCount * 3 + 1) / 2;
+  }
+  return pixelCount * sizeof(lv_color_t);
+}
+
+size_t LittleVgl::PreparePixelData(lv_color_t* pixels, size_t pixelCount) {
+  // LVGL doesn't read a buffer once it's been handed over for flushing, so it can be packed in place
+  if (lcd.GetColorFormat() == Drivers::St7789::ColorFormat::Rgb444) {
+    return Utility::PackRgb444(reinterpret_cast<uint8_t*>(pixels), pixelCount);
+  }
+  return pixelCount * sizeof(lv_color_t);
+}
+
+void LittleVgl::PlanFlushes(lv_disp_t* disp) {
+  ApplyPendingScroll();
+
+  // Full refreshes (and the scrolling animations that rely on them) are a single area already
+  if (disp->inv_p == 0 || IsScrolling()) {
+    return;
+  }
+
+  statistics.areasBefore += disp->inv_p;
+
+  // Nothing outside of the partial area is visible
+  if (hasPartialArea) {
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+      lv_area_t clipped;
+      if (disp->inv_area_joined[i] == 0 && _lv_area_intersect(&clipped, &disp->inv_areas[i], &partialArea)) {
+        disp->inv_areas[i] = clipped;
+      } else {
+        disp->inv_area_joined[i] = 1;
+      }
+    }
+  }
+
+  // Merge any two areas when drawing their bounding box costs less than drawing both.
+  // This covers overlapping areas as well as small neighbouring ones (labels on the same line)
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (uint16_t i = 0; i < disp->inv_p; i++) {
+      if (disp->inv_area_joined[i] != 0) {
+        continue;
+      }
+      for (uint16_t j = i + 1; j < disp->inv_p; j++) {
+        if (disp->inv_area_joined[j] != 0) {
+          continue;
+        }
+        lv_area_t joined;
+        _lv_area_join(&joined, &disp->inv_areas[i], &disp->inv_areas[j]);
+        if (FlushCost(joined) <= FlushCost(disp->inv_areas[i]) + FlushCost(disp->inv_areas[j])) {
+          disp->inv_areas[i] = joined;
+          disp->inv_area_joined[j] = 1;
+          merged = true;
+        }
+      }
+    }
+  }
+
+  // Drop the merged areas and send the others in the order the panel scans its lines
+  uint16_t count = 0;
+  for (uint16_t i = 0; i < disp->inv_p; i++) {
+    if (disp->inv_area_joined[i] != 0) {
+      continue;
+    }
+    lv_area_t area = disp->inv_areas[i];
+    uint16_t position = count;
+    while (position > 0 && (disp->inv_areas[position - 1].y1 > area.y1 ||
+                            (disp->inv_areas[position - 1].y1 == area.y1 && disp->inv_areas[position - 1].x1 > area.x1))) {
+      disp->inv_areas[position] = disp->inv_areas[position - 1];
+      position--;
+    }
+    disp->inv_areas[position] = area;
+    count++;
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    disp->inv_area_joined[i] = 0;
+  }
+  disp->inv_p = count;
+
+  statistics.areasAfter += count;
+}
+
+void LittleVgl::OnRefreshDone(uint32_t renderTime) {
+  statistics.frames++;
+  statistics.renderTime += renderTime;
+}
+
+void LittleVgl::RestartStatistics() {
+  TickType_t now = xTaskGetTickCount();
+  if (now - statisticsStartTime >= minStatisticsDuration) {
+    lastStatistics = statistics;
+    lastStatistics.duration = now - statisticsStartTime;
+  }
+  statistics = {};
+  statisticsStartTime = now;
+}
+
 bool LittleVgl::IsScrolling() {
   return scrollDirection != LittleVgl::FullRefreshDirections::None;
 }
@@ -214,24 +477,50 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     }
   }
 
+  statistics.flushes++;
+  statistics.spiBytes += windowSetupBytes;
+
   if (y2 < y1) {
     height = totalNbLines - y1;
 
     if (height > 0) {
-      lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+      size_t size = PreparePixelData(color_p, width * height);
+      statistics.spiBytes += windowSetupBytes + size;
+      lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), size);
     }
 
     uint16_t pixOffset = width * height;
     height = y2 + 1;
-    lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), width * height * 2);
+    size_t size = PreparePixelData(color_p + pixOffset, width * height);
+    statistics.spiBytes += size;
+    lcd.DrawBuffer(area->x1, 0, width, height, reinterpret_cast<const uint8_t*>(color_p + pixOffset), size, OnFlushDone, this);
 
   } else {
-    lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
+    size_t size = PreparePixelData(color_p, width * height);
+    statistics.spiBytes += size;
+    lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), size, OnFlushDone, this);
   }
 
+  // The transfer runs in the background: LVGL renders the next part into the other buffer meanwhile
+  // and is informed that this buffer can be reused in OnFlushDone()
+}
+
+void LittleVgl::OnFlushDone(void* instance) {
+  // Called from the SPI interrupt
+  auto* lvgl = static_cast<LittleVgl*>(instance);
   // IMPORTANT!!!
   // Inform the graphics library that you are ready with the flushing
-  lv_disp_flush_ready(&disp_drv);
+  lv_disp_flush_ready(&lvgl->disp_drv);
+
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  xSemaphoreGiveFromISR(lvgl->flushDone, &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+void LittleVgl::WaitForFlush() {
+  // LVGL re-checks its flushing flag after each call, so a stale give only causes one extra loop.
+  // The timeout guards against a transfer that never completes (SPI put to sleep)
+  xSemaphoreTake(flushDone, pdMS_TO_TICKS(10));
 }
 
 void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
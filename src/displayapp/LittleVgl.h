@@ -1,7 +1,10 @@
 #pragma once
 
+#include <FreeRTOS.h>
+#include <semphr.h>
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "displayapp/ImageCache.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -12,6 +15,20 @@ namespace Pinetime {
     class LittleVgl {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
+
+      struct Statistics {
+        TickType_t duration = 0;
+        // LVGL refreshes that drew something, and the time spent rendering them (ms)
+        uint32_t frames = 0;
+        uint32_t renderTime = 0;
+        uint32_t flushes = 0;
+        // Commands, arguments and pixels sent to the display
+        uint32_t spiBytes = 0;
+        // Invalidated areas reported by LVGL, and actually flushed after merging
+        uint32_t areasBefore = 0;
+        uint32_t areasAfter = 0;
+      };
+
       LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem);
 
       LittleVgl(const LittleVgl&) = delete;
@@ -22,6 +39,7 @@ namespace Pinetime {
       void Init();
 
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
+      void WaitForFlush();
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
@@ -29,6 +47,35 @@ namespace Pinetime {
       void ClearTouchState();
       bool IsScrolling();
 
+      // Sends 12-bit pixels (RGB444) instead of 16-bit ones, for screens that don't need the full colour depth
+      void SetReducedColorDepth(bool reduced);
+
+      // Moves content vertically by delta lines (down if positive). The pixels already drawn are moved with the
+      // display vertical scrolling, only the lines exposed by the move are rendered.
+      // Everything on screen moves with the display: content must cover its whole width and height
+      void ScrollContent(lv_obj_t* content, lv_coord_t delta);
+
+      // Only the given screen lines are driven by the display (always on mode), the areas outside are not flushed
+      void SetPartialArea(uint16_t firstLine, uint16_t lastLine);
+      // Back to driving the whole display, the lines that were not driven are redrawn
+      void ClearPartialArea();
+
+      void PlanFlushes(lv_disp_t* disp);
+      void OnRefreshDone(uint32_t renderTime);
+
+      // Starts a new measurement period. The results of the one that just ended are kept if it lasted at least
+      // minStatisticsDuration: screens only shown on the way to System info (e.g. the watch face displayed by the long
+      // press that precedes the longer press, the launcher, the settings) don't replace the screen being measured.
+      void RestartStatistics();
+
+      const Statistics& GetLastStatistics() const {
+        return lastStatistics;
+      }
+
+      const ImageCache::Statistics& GetImageCacheStatistics() const {
+        return imageCache.GetStatistics();
+      }
+
       bool GetFullRefresh() {
         bool returnValue = fullRefresh;
         if (fullRefresh) {
@@ -38,28 +85,51 @@ namespace Pinetime {
       }
 
     private:
+      static void OnFlushDone(void* instance);
       void InitDisplay();
       void InitTouchpad();
       void InitFileSystem();
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
+      ImageCache imageCache;
 
       lv_disp_buf_t disp_buf_2;
       lv_color_t buf2_1[LV_HOR_RES_MAX * 4];
       lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
 
       lv_disp_drv_t disp_drv;
+      SemaphoreHandle_t flushDone = nullptr;
 
       bool fullRefresh = false;
       static constexpr uint8_t nbWriteLines = 4;
       static constexpr uint16_t totalNbLines = 320;
       static constexpr uint16_t visibleNbLines = 240;
 
+      // Cost of a flush on top of its pixels, in bytes of SPI time: the window set and RAM write commands,
+      // and the interrupt/LVGL bookkeeping (~50us at 8MHz)
+      static constexpr uint32_t windowSetupBytes = 11;
+      static constexpr uint32_t flushOverheadBytes = 48;
+      uint32_t FlushCost(const lv_area_t& area) const;
+      uint32_t PixelDataSize(uint32_t pixelCount) const;
+      size_t PreparePixelData(lv_color_t* pixels, size_t pixelCount);
+
+      Statistics statistics;
+      Statistics lastStatistics;
+      TickType_t statisticsStartTime = 0;
+      static constexpr TickType_t minStatisticsDuration = pdMS_TO_TICKS(5000);
+
       static constexpr uint8_t MaxScrollOffset() {
         return LV_VER_RES_MAX - nbWriteLines;
       }
 
+      // Scrolling requested by ScrollContent(), applied to the display right before the exposed lines are drawn
+      int16_t pendingScroll = 0;
+      void ApplyPendingScroll();
+
+      bool hasPartialArea = false;
+      lv_area_t partialArea;
+
       FullRefreshDirections scrollDirection = FullRefreshDirections::None;
       uint16_t writeOffset = 0;
       uint16_t scrollOffset = 0;
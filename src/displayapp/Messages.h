@@ -24,6 +24,8 @@ namespace Pinetime {
         AlarmTriggered,
         Chime,
         BleRadioEnableToggle,
+        // Data the current screen may be subscribed to has changed, see DisplayApp::NotifyDataChanged()
+        DataChanged,
       };
     }
   }
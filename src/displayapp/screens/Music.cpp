@@ -140,12 +140,14 @@ Music::Music(Pinetime::Controllers::MusicService& music) : musicService(music) {
 
   frameB = false;
 
+  musicService.StartSession();
   musicService.event(Controllers::MusicService::EVENT_MUSIC_OPEN);
 
   taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
 }
 
 Music::~Music() {
+  musicService.StopSession();
   lv_task_del(taskRefresh);
   lv_style_reset(&btn_style);
   lv_obj_clean(lv_scr_act());
@@ -15,11 +15,13 @@ Notifications::Notifications(DisplayApp* app,
                              Pinetime::Controllers::AlertNotificationService& alertNotificationService,
                              Pinetime::Controllers::MotorController& motorController,
                              System::SystemTask& systemTask,
+                             Components::LittleVgl& lvgl,
                              Modes mode)
   : app {app},
     notificationManager {notificationManager},
     alertNotificationService {alertNotificationService},
     motorController {motorController},
+    lvgl {lvgl},
     wakeLock(systemTask),
     mode {mode} {
 
@@ -33,10 +35,11 @@ Notifications::Notifications(DisplayApp* app,
                                                      notification.category,
                                                      notificationManager.NbNotifications(),
                                                      alertNotificationService,
-                                                     motorController);
+                                                     motorController,
+                                                     lvgl);
     validDisplay = true;
   } else {
-    currentItem = std::make_unique<NotificationItem>(alertNotificationService, motorController);
+    currentItem = std::make_unique<NotificationItem>(alertNotificationService, motorController, lvgl);
     validDisplay = false;
   }
   if (mode == Modes::Preview) {
@@ -109,7 +112,8 @@ void Notifications::Refresh() {
                                                        notification.category,
                                                        notificationManager.NbNotifications(),
                                                        alertNotificationService,
-                                                       motorController);
+                                                       motorController,
+                                                       lvgl);
     } else {
       running = false;
     }
@@ -180,6 +184,9 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
       }
       return false;
     case Pinetime::Applications::TouchEvents::SwipeDown: {
+      if (validDisplay && currentItem->Scroll(false)) {
+        return true;
+      }
       Controllers::NotificationManager::Notification previousNotification;
       if (validDisplay) {
         previousNotification = notificationManager.GetPrevious(currentId);
@@ -202,10 +209,14 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
                                                        previousNotification.category,
                                                        notificationManager.NbNotifications(),
                                                        alertNotificationService,
-                                                       motorController);
+                                                       motorController,
+                                                       lvgl);
     }
       return true;
     case Pinetime::Applications::TouchEvents::SwipeUp: {
+      if (validDisplay && currentItem->Scroll(true)) {
+        return true;
+      }
       Controllers::NotificationManager::Notification nextNotification;
       if (validDisplay) {
         nextNotification = notificationManager.GetNext(currentId);
@@ -229,7 +240,8 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
                                                        nextNotification.category,
                                                        notificationManager.NbNotifications(),
                                                        alertNotificationService,
-                                                       motorController);
+                                                       motorController,
+                                                       lvgl);
     }
       return true;
     default:
@@ -245,14 +257,16 @@ namespace {
 }
 
 Notifications::NotificationItem::NotificationItem(Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                                                  Pinetime::Controllers::MotorController& motorController)
+                                                  Pinetime::Controllers::MotorController& motorController,
+                                                  Components::LittleVgl& lvgl)
   : NotificationItem("Notifications",
                      "No notifications to display",
                      0,
                      Controllers::NotificationManager::Categories::Unknown,
                      0,
                      alertNotificationService,
-                     motorController) {
+                     motorController,
+                     lvgl) {
 }
 
 Notifications::NotificationItem::NotificationItem(const char* title,
@@ -261,8 +275,9 @@ Notifications::NotificationItem::NotificationItem(const char* title,
                                                   Controllers::NotificationManager::Categories category,
                                                   uint8_t notifNb,
                                                   Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                                                  Pinetime::Controllers::MotorController& motorController)
-  : alertNotificationService {alertNotificationService}, motorController {motorController} {
+                                                  Pinetime::Controllers::MotorController& motorController,
+                                                  Components::LittleVgl& lvgl)
+  : alertNotificationService {alertNotificationService}, motorController {motorController}, lvgl {lvgl} {
   container = lv_cont_create(lv_scr_act(), nullptr);
   lv_obj_set_size(container, LV_HOR_RES, LV_VER_RES);
   lv_obj_set_style_local_bg_color(container, LV_CONT_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_BLACK);
@@ -308,9 +323,15 @@ Notifications::NotificationItem::NotificationItem(const char* title,
   lv_obj_set_width(alert_subject, LV_HOR_RES - 20);
 
   switch (category) {
-    default:
+    default: {
       lv_label_set_text(alert_subject, msg);
-      break;
+      // Grow the message box to fit long messages, they can then be scrolled
+      lv_coord_t subjectHeight = lv_obj_get_height(alert_subject) + 2 * 10;
+      if (subjectHeight > lv_obj_get_height(subject_container)) {
+        lv_obj_set_height(subject_container, subjectHeight);
+        lv_obj_set_height(container, lv_obj_get_y(subject_container) + subjectHeight);
+      }
+    } break;
     case Controllers::NotificationManager::Categories::IncomingCall: {
       lv_obj_set_height(subject_container, 108);
       lv_label_set_text_static(alert_subject, "Incoming call from");
@@ -369,6 +390,37 @@ void Notifications::NotificationItem::OnCallButtonEvent(lv_obj_t* obj, lv_event_
   running = false;
 }
 
+bool Notifications::NotificationItem::Scroll(bool forward) {
+  lv_coord_t lowestY = LV_VER_RES - lv_obj_get_height(container);
+  if (forward) {
+    if (scrollTarget <= lowestY) {
+      return false;
+    }
+    scrollTarget = std::max<lv_coord_t>(scrollTarget - scrollStep, lowestY);
+  } else {
+    if (scrollTarget >= 0) {
+      return false;
+    }
+    scrollTarget = std::min<lv_coord_t>(scrollTarget + scrollStep, 0);
+  }
+
+  // Move by a few lines on every frame, the display scrolls what is already drawn
+  lv_anim_t anim;
+  lv_anim_init(&anim);
+  lv_anim_set_var(&anim, this);
+  lv_anim_set_exec_cb(&anim, ScrollAnimationCallback);
+  lv_anim_set_values(&anim, lv_obj_get_y(container), scrollTarget);
+  lv_anim_set_time(&anim, 250);
+  lv_anim_start(&anim);
+  return true;
+}
+
+void Notifications::NotificationItem::ScrollAnimationCallback(void* instance, lv_anim_value_t y) {
+  auto* item = static_cast<NotificationItem*>(instance);
+  item->lvgl.ScrollContent(item->container, y - lv_obj_get_y(item->container));
+}
+
 Notifications::NotificationItem::~NotificationItem() {
+  lv_anim_del(this, ScrollAnimationCallback);
   lv_obj_clean(lv_scr_act());
 }
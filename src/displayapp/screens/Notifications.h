@@ -9,6 +9,7 @@
 #include "components/motor/MotorController.h"
 #include "systemtask/SystemTask.h"
 #include "systemtask/WakeLock.h"
+#include "displayapp/LittleVgl.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -26,6 +27,7 @@ namespace Pinetime {
                                Pinetime::Controllers::AlertNotificationService& alertNotificationService,
                                Pinetime::Controllers::MotorController& motorController,
                                System::SystemTask& systemTask,
+                               Components::LittleVgl& lvgl,
                                Modes mode);
         ~Notifications() override;
 
@@ -38,14 +40,16 @@ namespace Pinetime {
         class NotificationItem {
         public:
           NotificationItem(Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                           Pinetime::Controllers::MotorController& motorController);
+                           Pinetime::Controllers::MotorController& motorController,
+                           Components::LittleVgl& lvgl);
           NotificationItem(const char* title,
                            const char* msg,
                            uint8_t notifNr,
                            Controllers::NotificationManager::Categories,
                            uint8_t notifNb,
                            Pinetime::Controllers::AlertNotificationService& alertNotificationService,
-                           Pinetime::Controllers::MotorController& motorController);
+                           Pinetime::Controllers::MotorController& motorController,
+                           Components::LittleVgl& lvgl);
           ~NotificationItem();
 
           bool IsRunning() const {
@@ -54,7 +58,15 @@ namespace Pinetime {
 
           void OnCallButtonEvent(lv_obj_t*, lv_event_t event);
 
+          /** Scrolls a message that doesn't fit on the screen by about a page.
+           * @return false if the end of the message in that direction is already displayed */
+          bool Scroll(bool forward);
+
         private:
+          static void ScrollAnimationCallback(void* instance, lv_anim_value_t y);
+          static constexpr lv_coord_t scrollStep = LV_VER_RES_MAX - 60;
+          lv_coord_t scrollTarget = 0;
+
           lv_obj_t* container;
           lv_obj_t* subject_container;
           lv_obj_t* bt_accept;
@@ -65,6 +77,7 @@ namespace Pinetime {
           lv_obj_t* label_reject;
           Pinetime::Controllers::AlertNotificationService& alertNotificationService;
           Pinetime::Controllers::MotorController& motorController;
+          Components::LittleVgl& lvgl;
 
           bool running = true;
         };
@@ -74,6 +87,7 @@ namespace Pinetime {
         Pinetime::Controllers::NotificationManager& notificationManager;
         Pinetime::Controllers::AlertNotificationService& alertNotificationService;
         Pinetime::Controllers::MotorController& motorController;
+        Components::LittleVgl& lvgl;
         System::WakeLock wakeLock;
         Modes mode = Modes::Normal;
         std::unique_ptr<NotificationItem> currentItem;
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include "displayapp/TouchEvents.h"
+#include "displayapp/DataSources.h"
 #include <lvgl/lvgl.h>
 
 namespace Pinetime {
@@ -15,6 +16,11 @@ namespace Pinetime {
         }
 
       public:
+        struct AlwaysOnArea {
+          uint16_t firstLine;
+          uint16_t lastLine;
+        };
+
         explicit Screen() = default;
 
         virtual ~Screen() = default;
@@ -25,6 +31,40 @@ namespace Pinetime {
           return running;
         }
 
+        /** @return the DataSources this screen is refreshed on, DataSources::None if it refreshes itself with an lv_task */
+        uint8_t Subscriptions() const {
+          return subscriptions;
+        }
+
+        TimeResolution GetTimeResolution() const {
+          return timeResolution;
+        }
+
+        /** Called by DisplayApp when some of the given DataSources changed */
+        void OnDataChanged(uint8_t sources) {
+          if ((sources & subscriptions) != 0) {
+            Refresh();
+          }
+        }
+
+        /** @return period (ms) at which a subscribed screen must still be refreshed, e.g. while an animation is running.
+         * 0 if it only needs to be refreshed when its data changes */
+        virtual uint32_t PollPeriod() const {
+          return 0;
+        }
+
+        /** @return true if the screen can be drawn with 4 bits per colour channel (RGB444).
+         * This sends 25% less data to the display */
+        virtual bool ReducedColorDepth() const {
+          return false;
+        }
+
+        /** @return the lines of the screen that stay displayed in always on mode, the display doesn't drive the other ones.
+         * The whole screen by default */
+        virtual AlwaysOnArea GetAlwaysOnArea() const {
+          return {0, LV_VER_RES_MAX - 1};
+        }
+
         /** @return false if the button hasn't been handled by the app, true if it has been handled */
         virtual bool OnButtonPushed() {
           return false;
@@ -41,7 +81,17 @@ namespace Pinetime {
         }
 
       protected:
+        // Replaces the periodic refresh task: Refresh() is called when one of the sources changes
+        void Subscribe(uint8_t sources, TimeResolution resolution = TimeResolution::Minutes) {
+          subscriptions = sources;
+          timeResolution = resolution;
+        }
+
         bool running = true;
+
+      private:
+        uint8_t subscriptions = DataSources::None;
+        TimeResolution timeResolution = TimeResolution::Minutes;
       };
     }
   }
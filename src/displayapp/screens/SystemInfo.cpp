@@ -12,6 +12,7 @@
 #include "components/brightness/BrightnessController.h"
 #include "components/datetime/DateTimeController.h"
 #include "components/motion/MotionController.h"
+#include "components/fs/FS.h"
 #include "drivers/Watchdog.h"
 #include "displayapp/InfiniTimeTheme.h"
 
@@ -39,7 +40,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
                        const Pinetime::Drivers::Cst816S& touchPanel,
-                       const Pinetime::Drivers::SpiNorFlash& spiNorFlash)
+                       const Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                       const Pinetime::Controllers::FS& filesystem,
+                       const Pinetime::Components::LittleVgl& lvgl)
   : dateTimeController {dateTimeController},
     batteryController {batteryController},
     brightnessController {brightnessController},
@@ -48,6 +51,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     motionController {motionController},
     touchPanel {touchPanel},
     spiNorFlash {spiNorFlash},
+    filesystem {filesystem},
+    lvgl {lvgl},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -64,6 +69,12 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen7();
               }},
              Screens::ScreenListModes::UpDown} {
 }
@@ -96,7 +107,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, 7, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -175,7 +186,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, 7, label);
 }
 
 extern int mallocFailedCount;
@@ -214,7 +225,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         mallocFailedCount,
                         stackOverflowCount);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, 7, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
@@ -280,10 +291,78 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(3, 7, infoTask);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+  // Display cost of the screen shown before this one
+  const auto& stats = lvgl.GetLastStatistics();
+  const auto& images = lvgl.GetImageCacheStatistics();
+  uint32_t imageReads = std::max<uint32_t>(1, images.hits + images.misses);
+
+  uint32_t seconds = std::max<uint32_t>(1, stats.duration / configTICK_RATE_HZ);
+  uint32_t frames = std::max<uint32_t>(1, stats.frames);
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#808080 Display# (prev. app)\n"
+                        " #808080 Duration# %lus\n"
+                        " #808080 Frames/s# %lu\n"
+                        " #808080 Flushes/s# %lu\n"
+                        " #808080 SPI B/frame# %lu\n"
+                        " #808080 Render ms/frame# %lu\n"
+                        " #808080 Areas# %lu -> %lu\n"
+                        "#808080 Image cache#\n"
+                        " #808080 Hits# %lu%%\n"
+                        " #808080 Used# %lu B",
+                        stats.duration / configTICK_RATE_HZ,
+                        stats.frames / seconds,
+                        stats.flushes / seconds,
+                        stats.spiBytes / frames,
+                        stats.renderTime / frames,
+                        stats.areasBefore,
+                        stats.areasAfter,
+                        images.hits * 100 / imageReads,
+                        images.used);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(4, 7, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
+  // External flash traffic since boot
+  const auto& flash = spiNorFlash.GetStatistics();
+  const auto& cache = filesystem.GetCacheStatistics();
+  uint32_t cacheReads = std::max<uint32_t>(1, cache.hits + cache.misses);
+
+  lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
+  lv_label_set_recolor(label, true);
+  lv_label_set_text_fmt(label,
+                        "#808080 Flash# (since boot)\n"
+                        " #808080 Reads# %lu\n"
+                        "  %lu KB\n"
+                        " #808080 Programs# %lu\n"
+                        "  %lu KB\n"
+                        " #808080 Erases# %lu\n"
+                        " #808080 Busy# %lu ms\n"
+                        "#808080 FS cache#\n"
+                        " #808080 Hits# %lu%%\n"
+                        " #808080 Read-ahead# %lu\n"
+                        " #808080 Bypassed# %lu",
+                        flash.reads,
+                        flash.readBytes / 1024,
+                        flash.programs,
+                        flash.programBytes / 1024,
+                        flash.erases,
+                        flash.busyTime * 1000 / configTICK_RATE_HZ,
+                        cache.hits * 100 / cacheReads,
+                        cache.readAheadHits,
+                        cache.bypassed);
+  lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
+  return std::make_unique<Screens::Label>(5, 7, label);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen7() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -297,5 +376,5 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(6, 7, label);
 }
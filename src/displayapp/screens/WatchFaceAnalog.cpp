@@ -157,14 +157,12 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   lv_style_set_line_rounded(&hour_line_style_trace, LV_STATE_DEFAULT, false);
   lv_obj_add_style(hour_body_trace, LV_LINE_PART_MAIN, &hour_line_style_trace);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Notifications, TimeResolution::Seconds);
 
   Refresh();
 }
 
 WatchFaceAnalog::~WatchFaceAnalog() {
-  lv_task_del(taskRefresh);
-
   lv_style_reset(&hour_line_style);
   lv_style_reset(&hour_line_style_trace);
   lv_style_reset(&minute_line_style);
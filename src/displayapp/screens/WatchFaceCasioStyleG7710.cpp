@@ -4,6 +4,7 @@
 #include <cstdio>
 #include "displayapp/screens/BatteryIcon.h"
 #include "displayapp/screens/BleIcon.h"
+#include "displayapp/ExternalFont.h"
 #include "displayapp/screens/NotificationIcon.h"
 #include "displayapp/screens/Symbols.h"
 #include "components/battery/BatteryController.h"
@@ -32,21 +33,10 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
     heartRateController {heartRateController},
     motionController {motionController} {
 
-  lfs_file f = {};
-  if (filesystem.FileOpen(&f, "/fonts/lv_font_dots_40.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_dot40 = lv_font_load("F:/fonts/lv_font_dots_40.bin");
-  }
-
-  if (filesystem.FileOpen(&f, "/fonts/7segments_40.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_segment40 = lv_font_load("F:/fonts/7segments_40.bin");
-  }
-
-  if (filesystem.FileOpen(&f, "/fonts/7segments_115.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_segment115 = lv_font_load("F:/fonts/7segments_115.bin");
-  }
+  font_dot40 = Components::ExternalFont::Load(filesystem, "/fonts/lv_font_dots_40.bin");
+  font_segment40 = Components::ExternalFont::Load(filesystem, "/fonts/7segments_40.bin");
+  font_segment115 = Components::ExternalFont::Load(filesystem, "/fonts/7segments_115.bin");
+  Components::ExternalFont::Prefetch(font_segment115, "0123456789");
 
   label_battery_value = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_align(label_battery_value, lv_scr_act(), LV_ALIGN_IN_TOP_RIGHT, 0, 0);
@@ -168,27 +158,18 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
   lv_label_set_text_static(stepIcon, Symbols::shoe);
   lv_obj_align(stepIcon, stepValue, LV_ALIGN_OUT_LEFT_MID, -5, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Steps | DataSources::HeartRate |
+            DataSources::Notifications);
   Refresh();
 }
 
 WatchFaceCasioStyleG7710::~WatchFaceCasioStyleG7710() {
-  lv_task_del(taskRefresh);
-
   lv_style_reset(&style_line);
   lv_style_reset(&style_border);
 
-  if (font_dot40 != nullptr) {
-    lv_font_free(font_dot40);
-  }
-
-  if (font_segment40 != nullptr) {
-    lv_font_free(font_segment40);
-  }
-
-  if (font_segment115 != nullptr) {
-    lv_font_free(font_segment115);
-  }
+  Components::ExternalFont::Free(font_dot40);
+  Components::ExternalFont::Free(font_segment40);
+  Components::ExternalFont::Free(font_segment115);
 
   lv_obj_clean(lv_scr_act());
 }
@@ -313,22 +294,7 @@ void WatchFaceCasioStyleG7710::Refresh() {
 }
 
 bool WatchFaceCasioStyleG7710::IsAvailable(Pinetime::Controllers::FS& filesystem) {
-  lfs_file file = {};
-
-  if (filesystem.FileOpen(&file, "/fonts/lv_font_dots_40.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/7segments_40.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/7segments_115.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  return true;
+  auto& resources = filesystem.Resources();
+  return resources.Exists("/fonts/lv_font_dots_40.bin") && resources.Exists("/fonts/7segments_40.bin") &&
+         resources.Exists("/fonts/7segments_115.bin");
 }
@@ -1,6 +1,7 @@
 #include "displayapp/screens/WatchFaceDigital.h"
 
 #include <lvgl/lvgl.h>
+#include <algorithm>
 #include <cstdio>
 
 #include "displayapp/screens/NotificationIcon.h"
@@ -86,15 +87,27 @@ WatchFaceDigital::WatchFaceDigital(Controllers::DateTime& dateTimeController,
   lv_label_set_text_static(stepIcon, Symbols::shoe);
   lv_obj_align(stepIcon, stepValue, LV_ALIGN_OUT_LEFT_MID, -5, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Steps | DataSources::HeartRate |
+            DataSources::Notifications | DataSources::Weather);
   Refresh();
 }
 
 WatchFaceDigital::~WatchFaceDigital() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
+Screen::AlwaysOnArea WatchFaceDigital::GetAlwaysOnArea() const {
+  // Only keep the time and date displayed
+  lv_area_t time;
+  lv_area_t ampm;
+  lv_area_t date;
+  lv_obj_get_coords(label_time, &time);
+  lv_obj_get_coords(label_time_ampm, &ampm);
+  lv_obj_get_coords(label_date, &date);
+  return {static_cast<uint16_t>(std::max<lv_coord_t>(0, std::min({time.y1, ampm.y1, date.y1}))),
+          static_cast<uint16_t>(std::max({time.y2, ampm.y2, date.y2}))};
+}
+
 void WatchFaceDigital::Refresh() {
   statusIcons.Update();
 
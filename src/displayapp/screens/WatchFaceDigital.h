@@ -40,6 +40,7 @@ namespace Pinetime {
         ~WatchFaceDigital() override;
 
         void Refresh() override;
+        AlwaysOnArea GetAlwaysOnArea() const override;
 
       private:
         uint8_t displayedHour = -1;
@@ -72,7 +73,6 @@ namespace Pinetime {
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
 
-        lv_task_t* taskRefresh;
         Widgets::StatusIcons statusIcons;
       };
     }
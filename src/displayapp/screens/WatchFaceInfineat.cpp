@@ -4,6 +4,7 @@
 #include <cstdio>
 #include "displayapp/screens/Symbols.h"
 #include "displayapp/screens/BleIcon.h"
+#include "displayapp/ExternalFont.h"
 #include "components/settings/Settings.h"
 #include "components/battery/BatteryController.h"
 #include "components/ble/BleController.h"
@@ -133,16 +134,9 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
     notificationManager {notificationManager},
     settingsController {settingsController},
     motionController {motionController} {
-  lfs_file f = {};
-  if (filesystem.FileOpen(&f, "/fonts/teko.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_teko = lv_font_load("F:/fonts/teko.bin");
-  }
-
-  if (filesystem.FileOpen(&f, "/fonts/bebas.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_bebas = lv_font_load("F:/fonts/bebas.bin");
-  }
+  font_teko = Components::ExternalFont::Load(filesystem, "/fonts/teko.bin");
+  font_bebas = Components::ExternalFont::Load(filesystem, "/fonts/bebas.bin");
+  Components::ExternalFont::Prefetch(font_bebas, "0123456789");
 
   // Side Cover
   static constexpr lv_point_t linePoints[nLines][2] = {{{30, 25}, {68, -8}},
@@ -296,19 +290,13 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
   lv_label_set_text_static(labelBtnSettings, Symbols::settings);
   lv_obj_set_hidden(btnSettings, true);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Steps | DataSources::Notifications);
   Refresh();
 }
 
 WatchFaceInfineat::~WatchFaceInfineat() {
-  lv_task_del(taskRefresh);
-
-  if (font_bebas != nullptr) {
-    lv_font_free(font_bebas);
-  }
-  if (font_teko != nullptr) {
-    lv_font_free(font_teko);
-  }
+  Components::ExternalFont::Free(font_bebas);
+  Components::ExternalFont::Free(font_teko);
 
   lv_obj_clean(lv_scr_act());
 }
@@ -470,6 +458,18 @@ void WatchFaceInfineat::Refresh() {
   }
 }
 
+uint32_t WatchFaceInfineat::PollPeriod() const {
+  // Charging animation
+  if (batteryController.IsCharging()) {
+    return 150;
+  }
+  // Hide the settings button after a timeout
+  if (savedTick > 0 && !lv_obj_get_hidden(btnSettings)) {
+    return 500;
+  }
+  return 0;
+}
+
 void WatchFaceInfineat::SetBatteryLevel(uint8_t batteryPercent) {
   // starting point (y) + Pine64 logo height * (100 - batteryPercent) / 100
   lineBatteryPoints[1] = {27, static_cast<lv_coord_t>(105 + 32 * (100 - batteryPercent) / 100)};
@@ -491,22 +491,6 @@ void WatchFaceInfineat::ToggleBatteryIndicatorColor(bool showSideCover) {
 }
 
 bool WatchFaceInfineat::IsAvailable(Pinetime::Controllers::FS& filesystem) {
-  lfs_file file = {};
-
-  if (filesystem.FileOpen(&file, "/fonts/teko.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/bebas.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/images/pine_small.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
-  return true;
+  auto& resources = filesystem.Resources();
+  return resources.Exists("/fonts/teko.bin") && resources.Exists("/fonts/bebas.bin") && resources.Exists("/images/pine_small.bin");
 }
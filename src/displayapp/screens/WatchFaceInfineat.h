@@ -41,6 +41,7 @@ namespace Pinetime {
         void CloseMenu();
 
         void Refresh() override;
+        uint32_t PollPeriod() const override;
 
         static bool IsAvailable(Pinetime::Controllers::FS& filesystem);
 
@@ -95,7 +96,6 @@ namespace Pinetime {
         void SetBatteryLevel(uint8_t batteryPercent);
         void ToggleBatteryIndicatorColor(bool showSideCover);
 
-        lv_task_t* taskRefresh;
         lv_font_t* font_teko = nullptr;
         lv_font_t* font_bebas = nullptr;
       };
@@ -394,12 +394,12 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
   lv_label_set_text_static(lblSetOpts, Symbols::settings);
   lv_obj_set_hidden(btnSetOpts, true);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Steps | DataSources::Notifications |
+            DataSources::Weather, TimeResolution::Seconds);
   Refresh();
 }
 
 WatchFacePineTimeStyle::~WatchFacePineTimeStyle() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
@@ -566,6 +566,14 @@ void WatchFacePineTimeStyle::Refresh() {
   }
 }
 
+uint32_t WatchFacePineTimeStyle::PollPeriod() const {
+  // Hide the settings buttons after a timeout
+  if (savedTick > 0 && !lv_obj_get_hidden(btnSetColor)) {
+    return 200;
+  }
+  return 0;
+}
+
 void WatchFacePineTimeStyle::UpdateSelected(lv_obj_t* object, lv_event_t event) {
   auto valueTime = settingsController.GetPTSColorTime();
   auto valueBar = settingsController.GetPTSColorBar();
@@ -40,6 +40,7 @@ namespace Pinetime {
         bool OnButtonPushed() override;
 
         void Refresh() override;
+        uint32_t PollPeriod() const override;
 
         void UpdateSelected(lv_obj_t* object, lv_event_t event);
 
@@ -117,7 +118,6 @@ namespace Pinetime {
         void SetBatteryIcon();
         void CloseMenu();
 
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -163,12 +163,11 @@ WatchFacePrideFlag::WatchFacePrideFlag(Controllers::DateTime& dateTimeController
 
   UpdateScreen(settingsController.GetPrideFlag());
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Steps | DataSources::Notifications, TimeResolution::Seconds);
   Refresh();
 }
 
 WatchFacePrideFlag::~WatchFacePrideFlag() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
@@ -282,6 +281,7 @@ void WatchFacePrideFlag::UpdateSelected(lv_obj_t* object, lv_event_t event) {
     settingsController.SetPrideFlag(valueFlag);
     if (flagChanged) {
       UpdateScreen(valueFlag);
+      Refresh();
     }
   }
 }
@@ -71,12 +71,12 @@ WatchFaceTerminal::WatchFaceTerminal(Controllers::DateTime& dateTimeController,
 
   lv_obj_align(container, nullptr, LV_ALIGN_IN_TOP_LEFT, 0, 7);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  Subscribe(DataSources::Time | DataSources::Battery | DataSources::Ble | DataSources::Steps | DataSources::HeartRate |
+            DataSources::Notifications | DataSources::Weather, TimeResolution::Seconds);
   Refresh();
 }
 
 WatchFaceTerminal::~WatchFaceTerminal() {
-  lv_task_del(taskRefresh);
   lv_obj_clean(lv_scr_act());
 }
 
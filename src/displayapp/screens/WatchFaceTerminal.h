@@ -37,6 +37,11 @@ namespace Pinetime {
 
         void Refresh() override;
 
+        // Flat text colours only, they are not affected by the reduced colour depth
+        bool ReducedColorDepth() const override {
+          return true;
+        }
+
       private:
         Utility::DirtyValue<int> batteryPercentRemaining {};
         Utility::DirtyValue<bool> powerPresent {};
@@ -71,7 +76,6 @@ namespace Pinetime {
         Controllers::MotionController& motionController;
         Controllers::SimpleWeatherService& weatherService;
 
-        lv_task_t* taskRefresh;
       };
     }
 
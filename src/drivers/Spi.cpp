@@ -9,14 +9,35 @@ Spi::Spi(SpiMaster& spiMaster, uint8_t pinCsn) : spiMaster {spiMaster}, pinCsn {
   nrf_gpio_pin_set(pinCsn);
 }
 
-bool Spi::Write(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
-  return spiMaster.Write(pinCsn, data, size, preTransactionHook);
+bool Spi::Write(const uint8_t* data,
+                size_t size,
+                const std::function<void()>& preTransactionHook,
+                SpiMaster::TransactionDoneCallback transactionDone,
+                void* transactionDoneContext) {
+  return spiMaster.Write(pinCsn, data, size, preTransactionHook, transactionDone, transactionDoneContext);
+}
+
+bool Spi::WriteSegments(uint8_t pinDataCommand,
+                        const SpiMaster::Segment* segments,
+                        size_t segmentCount,
+                        SpiMaster::TransactionDoneCallback transactionDone,
+                        void* transactionDoneContext) {
+  return spiMaster.WriteSegments(pinCsn, pinDataCommand, segments, segmentCount, transactionDone, transactionDoneContext);
 }
 
 bool Spi::Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
   return spiMaster.Read(pinCsn, cmd, cmdSize, data, dataSize);
 }
 
+bool Spi::ReadAsync(const uint8_t* cmd,
+                    size_t cmdSize,
+                    uint8_t* data,
+                    size_t dataSize,
+                    SpiMaster::TransactionDoneCallback transactionDone,
+                    void* transactionDoneContext) {
+  return spiMaster.ReadAsync(pinCsn, cmd, cmdSize, data, dataSize, transactionDone, transactionDoneContext);
+}
+
 void Spi::Sleep() {
   nrf_gpio_cfg_default(pinCsn);
   NRF_LOG_INFO("[SPI] Sleep")
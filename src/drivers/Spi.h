@@ -15,8 +15,23 @@ namespace Pinetime {
       Spi& operator=(Spi&&) = delete;
 
       bool Init();
-      bool Write(const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
+      bool Write(const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 SpiMaster::TransactionDoneCallback transactionDone = nullptr,
+                 void* transactionDoneContext = nullptr);
+      bool WriteSegments(uint8_t pinDataCommand,
+                         const SpiMaster::Segment* segments,
+                         size_t segmentCount,
+                         SpiMaster::TransactionDoneCallback transactionDone = nullptr,
+                         void* transactionDoneContext = nullptr);
       bool Read(uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      bool ReadAsync(const uint8_t* cmd,
+                     size_t cmdSize,
+                     uint8_t* data,
+                     size_t dataSize,
+                     SpiMaster::TransactionDoneCallback transactionDone,
+                     void* transactionDoneContext);
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
       void Sleep();
       void Wakeup();
@@ -87,6 +87,8 @@ bool SpiMaster::Init() {
 
   spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Enabled << SPIM_ENABLE_ENABLE_Pos);
 
+  SetupListChaining();
+
   NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
   NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
 
@@ -140,17 +142,32 @@ void SpiMaster::OnEndEvent() {
     return;
   }
 
-  auto s = currentBufferSize;
-  if (s > 0) {
-    auto currentSize = std::min((size_t) 255, s);
-    PrepareTx(currentBufferAddr, currentSize);
-    currentBufferAddr = currentBufferAddr + currentSize;
-    currentBufferSize = currentBufferSize - currentSize;
+  if (!readActive) {
+    statistics.interrupts++;
+  }
+  if (listActive) {
+    DisableListChaining();
+  }
 
-    spiBaseAddress->TASKS_START = 1;
+  if (currentBufferSize > 0) {
+    StartTransfer();
+  } else if (segmentsLeft > 0) {
+    StartSegment();
+  } else if (readSize > 0) {
+    StartReceive();
   } else {
     nrf_gpio_pin_set(this->pinCsn);
     currentBufferAddr = 0;
+    receiving = false;
+    if (readActive) {
+      readActive = false;
+    } else {
+      statistics.transfers++;
+    }
+    if (transactionDone != nullptr) {
+      transactionDone(transactionDoneContext);
+      transactionDone = nullptr;
+    }
     BaseType_t xHigherPriorityTaskWoken = pdFALSE;
     xSemaphoreGiveFromISR(mutex, &xHigherPriorityTaskWoken);
     portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
@@ -158,6 +175,9 @@ void SpiMaster::OnEndEvent() {
 }
 
 void SpiMaster::OnStartedEvent() {
+  if (currentBufferAddr != 0 && !readActive) {
+    statistics.interrupts++;
+  }
 }
 
 void SpiMaster::PrepareTx(const uint32_t bufferAddress, const size_t size) {
@@ -170,6 +190,128 @@ void SpiMaster::PrepareTx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
+void SpiMaster::SetupListChaining() {
+  NRF_TIMER3->TASKS_STOP = 1;
+  NRF_TIMER3->MODE = TIMER_MODE_MODE_Counter << TIMER_MODE_MODE_Pos;
+  NRF_TIMER3->BITMODE = TIMER_BITMODE_BITMODE_16Bit << TIMER_BITMODE_BITMODE_Pos;
+  NRF_TIMER3->INTENSET = TIMER_INTENSET_COMPARE1_Msk;
+
+  // END -> START restarts the SPIM on the next chunk of the list
+  nrf_ppi_channel_endpoint_setup(listRestartPpi,
+                                 reinterpret_cast<uint32_t>(&spiBaseAddress->EVENTS_END),
+                                 reinterpret_cast<uint32_t>(&spiBaseAddress->TASKS_START));
+  nrf_ppi_channel_include_in_group(listRestartPpi, listPpiGroup);
+  // END -> COUNT keeps track of the chunks already sent
+  nrf_ppi_channel_endpoint_setup(listCountPpi,
+                                 reinterpret_cast<uint32_t>(&spiBaseAddress->EVENTS_END),
+                                 reinterpret_cast<uint32_t>(&NRF_TIMER3->TASKS_COUNT));
+  // Once the last chunk is started, stop restarting the SPIM
+  nrf_ppi_channel_endpoint_setup(listStopPpi,
+                                 reinterpret_cast<uint32_t>(&NRF_TIMER3->EVENTS_COMPARE[0]),
+                                 reinterpret_cast<uint32_t>(&NRF_PPI->TASKS_CHG[listPpiGroup].DIS));
+
+  NRFX_IRQ_PRIORITY_SET(TIMER3_IRQn, 2);
+  NRFX_IRQ_ENABLE(TIMER3_IRQn);
+}
+
+size_t SpiMaster::ListChunkSize(size_t size) {
+  // Prefer a chunk size that divides the buffer exactly so that it is sent with a single interrupt.
+  // LVGL buffers are made of 240 pixel wide lines, so this is almost always the case
+  for (size_t chunkSize = maxChunkSize; chunkSize > maxChunkSize / 2; chunkSize--) {
+    if (size % chunkSize == 0) {
+      return chunkSize;
+    }
+  }
+  return maxChunkSize;
+}
+
+void SpiMaster::StartTransfer() {
+  size_t chunkSize = std::min(maxChunkSize, (size_t) currentBufferSize);
+  size_t chunkCount = 1;
+  if (currentBufferSize > maxChunkSize) {
+    chunkSize = ListChunkSize(currentBufferSize);
+    chunkCount = currentBufferSize / chunkSize;
+  }
+
+  if (receiving) {
+    PrepareRx(currentBufferAddr, chunkSize);
+  } else {
+    PrepareTx(currentBufferAddr, chunkSize);
+  }
+  if (chunkCount > 1) {
+    EnableListChaining(chunkCount);
+  }
+  currentBufferAddr = currentBufferAddr + chunkSize * chunkCount;
+  currentBufferSize = currentBufferSize - chunkSize * chunkCount;
+
+  spiBaseAddress->TASKS_START = 1;
+}
+
+void SpiMaster::StartSegment() {
+  const Segment* segment = currentSegment;
+  if (segment->isCommand) {
+    nrf_gpio_pin_clear(pinDataCommand);
+  } else {
+    nrf_gpio_pin_set(pinDataCommand);
+  }
+  currentSegment = segment + 1;
+  segmentsLeft = segmentsLeft - 1;
+
+  currentBufferAddr = (uint32_t) segment->data;
+  currentBufferSize = segment->size;
+  StartTransfer();
+}
+
+void SpiMaster::StartReceive() {
+  receiving = true;
+  currentBufferAddr = (uint32_t) readBuffer;
+  currentBufferSize = readSize;
+  readSize = 0;
+  StartTransfer();
+}
+
+void SpiMaster::EnableListChaining(size_t chunkCount) {
+  // TXD.PTR (or RXD.PTR) is advanced by MAXCNT after each chunk
+  if (receiving) {
+    spiBaseAddress->RXD.LIST = SPIM_RXD_LIST_LIST_ArrayList << SPIM_RXD_LIST_LIST_Pos;
+  } else {
+    spiBaseAddress->TXD.LIST = SPIM_TXD_LIST_LIST_ArrayList << SPIM_TXD_LIST_LIST_Pos;
+  }
+  // Intermediate END and STARTED events are handled by PPI (STOPPED doesn't occur), completion is reported by the
+  // TIMER3 interrupt: the whole list costs a single interrupt
+  spiBaseAddress->INTENCLR = (1 << 6);
+  spiBaseAddress->INTENCLR = (1 << 1);
+  spiBaseAddress->INTENCLR = (1 << 19);
+
+  NRF_TIMER3->TASKS_CLEAR = 1;
+  NRF_TIMER3->CC[0] = chunkCount - 1;
+  NRF_TIMER3->CC[1] = chunkCount;
+  NRF_TIMER3->EVENTS_COMPARE[0] = 0;
+  NRF_TIMER3->EVENTS_COMPARE[1] = 0;
+  NRF_TIMER3->TASKS_START = 1;
+
+  nrf_ppi_channel_enable(listCountPpi);
+  nrf_ppi_channel_enable(listStopPpi);
+  nrf_ppi_group_enable(listPpiGroup);
+  listActive = true;
+}
+
+void SpiMaster::DisableListChaining() {
+  nrf_ppi_group_disable(listPpiGroup);
+  nrf_ppi_channel_disable(listStopPpi);
+  nrf_ppi_channel_disable(listCountPpi);
+  NRF_TIMER3->TASKS_STOP = 1;
+
+  spiBaseAddress->TXD.LIST = 0;
+  spiBaseAddress->RXD.LIST = 0;
+  spiBaseAddress->EVENTS_END = 0;
+  spiBaseAddress->EVENTS_STARTED = 0;
+  spiBaseAddress->INTENSET = (1 << 6);
+  spiBaseAddress->INTENSET = (1 << 1);
+  spiBaseAddress->INTENSET = (1 << 19);
+  listActive = false;
+}
+
 void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->TXD.PTR = 0;
   spiBaseAddress->TXD.MAXCNT = 0;
@@ -180,13 +322,21 @@ void SpiMaster::PrepareRx(const uint32_t bufferAddress, const size_t size) {
   spiBaseAddress->EVENTS_END = 0;
 }
 
-bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook) {
+bool SpiMaster::Write(uint8_t pinCsn,
+                      const uint8_t* data,
+                      size_t size,
+                      const std::function<void()>& preTransactionHook,
+                      TransactionDoneCallback transactionDone,
+                      void* transactionDoneContext) {
   if (data == nullptr)
     return false;
   auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
   ASSERT(ok == true);
 
   this->pinCsn = pinCsn;
+  this->transactionDone = transactionDone;
+  this->transactionDoneContext = transactionDoneContext;
+  segmentsLeft = 0;
 
   if (size == 1) {
     SetupWorkaroundForErratum58();
@@ -199,14 +349,11 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const st
   }
   nrf_gpio_pin_clear(this->pinCsn);
 
+  statistics.bytes += size;
+  receiving = false;
   currentBufferAddr = (uint32_t) data;
   currentBufferSize = size;
-
-  auto currentSize = std::min((size_t) 255, (size_t) currentBufferSize);
-  PrepareTx(currentBufferAddr, currentSize);
-  currentBufferSize = currentBufferSize - currentSize;
-  currentBufferAddr = currentBufferAddr + currentSize;
-  spiBaseAddress->TASKS_START = 1;
+  StartTransfer();
 
   if (size == 1) {
     while (spiBaseAddress->EVENTS_END == 0)
@@ -216,12 +363,50 @@ bool SpiMaster::Write(uint8_t pinCsn, const uint8_t* data, size_t size, const st
 
     DisableWorkaroundForErratum58();
 
+    if (this->transactionDone != nullptr) {
+      this->transactionDone(this->transactionDoneContext);
+      this->transactionDone = nullptr;
+    }
+
     xSemaphoreGive(mutex);
   }
 
   return true;
 }
 
+bool SpiMaster::WriteSegments(uint8_t pinCsn,
+                              uint8_t pinDataCommand,
+                              const Segment* segments,
+                              size_t segmentCount,
+                              TransactionDoneCallback transactionDone,
+                              void* transactionDoneContext) {
+  if (segments == nullptr || segmentCount == 0)
+    return false;
+  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
+  ASSERT(ok == true);
+
+  this->pinCsn = pinCsn;
+  this->pinDataCommand = pinDataCommand;
+  this->transactionDone = transactionDone;
+  this->transactionDoneContext = transactionDoneContext;
+
+  // Erratum 58 only affects transfers with RXD.MAXCNT == 1: single byte segments are sent TX only
+  // and don't need the workaround, so the whole list runs from the END interrupt without blocking
+  DisableWorkaroundForErratum58();
+
+  for (size_t i = 0; i < segmentCount; i++) {
+    statistics.bytes += segments[i].size;
+  }
+  currentSegment = segments;
+  segmentsLeft = segmentCount;
+  receiving = false;
+
+  nrf_gpio_pin_clear(this->pinCsn);
+  StartSegment();
+
+  return true;
+}
+
 bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize) {
   xSemaphoreTake(mutex, portMAX_DELAY);
 
@@ -253,6 +438,40 @@ bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data
   return true;
 }
 
+bool SpiMaster::ReadAsync(uint8_t pinCsn,
+                          const uint8_t* cmd,
+                          size_t cmdSize,
+                          uint8_t* data,
+                          size_t dataSize,
+                          TransactionDoneCallback transactionDone,
+                          void* transactionDoneContext) {
+  if (cmd == nullptr || cmdSize == 0 || cmdSize > maxReadCommandSize || data == nullptr || dataSize == 0)
+    return false;
+  auto ok = xSemaphoreTake(mutex, portMAX_DELAY);
+  ASSERT(ok == true);
+
+  this->pinCsn = pinCsn;
+  this->transactionDone = transactionDone;
+  this->transactionDoneContext = transactionDoneContext;
+  segmentsLeft = 0;
+
+  // The caller's command may live on its stack, EasyDMA reads it from here
+  std::copy_n(cmd, cmdSize, readCommand);
+  readBuffer = data;
+  readSize = dataSize;
+  readActive = true;
+
+  DisableWorkaroundForErratum58();
+  nrf_gpio_pin_clear(this->pinCsn);
+
+  receiving = false;
+  currentBufferAddr = (uint32_t) readCommand;
+  currentBufferSize = cmdSize;
+  StartTransfer();
+
+  return true;
+}
+
 void SpiMaster::Sleep() {
   while (spiBaseAddress->ENABLE != 0) {
     spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
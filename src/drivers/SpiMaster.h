@@ -17,6 +17,22 @@ namespace Pinetime {
       enum class BitOrder : uint8_t { Msb_Lsb, Lsb_Msb };
       enum class Modes : uint8_t { Mode0, Mode1, Mode2, Mode3 };
       enum class Frequencies : uint8_t { Freq8Mhz };
+      using TransactionDoneCallback = void (*)(void* context);
+
+      // Part of a transaction sent with WriteSegments(), with the data/command pin set accordingly
+      struct Segment {
+        const uint8_t* data;
+        size_t size;
+        bool isCommand;
+      };
+
+      struct Statistics {
+        // Asynchronous writes that ran to completion (reads are not counted)
+        uint32_t transfers = 0;
+        // SPIM (STARTED, END) and TIMER3 interrupts serviced for those writes
+        uint32_t interrupts = 0;
+        uint32_t bytes = 0;
+      };
 
       struct Parameters {
         BitOrder bitOrder;
@@ -34,14 +50,43 @@ namespace Pinetime {
       SpiMaster& operator=(SpiMaster&&) = delete;
 
       bool Init();
-      bool Write(uint8_t pinCsn, const uint8_t* data, size_t size, const std::function<void()>& preTransactionHook);
+      bool Write(uint8_t pinCsn,
+                 const uint8_t* data,
+                 size_t size,
+                 const std::function<void()>& preTransactionHook,
+                 TransactionDoneCallback transactionDone = nullptr,
+                 void* transactionDoneContext = nullptr);
+      bool WriteSegments(uint8_t pinCsn,
+                         uint8_t pinDataCommand,
+                         const Segment* segments,
+                         size_t segmentCount,
+                         TransactionDoneCallback transactionDone = nullptr,
+                         void* transactionDoneContext = nullptr);
       bool Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data, size_t dataSize);
+      // Sends cmd, then receives dataSize bytes into data. Returns once the transfer is started,
+      // transactionDone is called from the SPIM interrupt when data has been filled.
+      // cmd is copied and can be released immediately, data must stay valid until completion.
+      bool ReadAsync(uint8_t pinCsn,
+                     const uint8_t* cmd,
+                     size_t cmdSize,
+                     uint8_t* data,
+                     size_t dataSize,
+                     TransactionDoneCallback transactionDone,
+                     void* transactionDoneContext);
 
       bool WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
 
       void OnStartedEvent();
       void OnEndEvent();
 
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
+      void ResetStatistics() {
+        statistics = {};
+      }
+
       void Sleep();
       void Wakeup();
 
@@ -50,6 +95,13 @@ namespace Pinetime {
       void DisableWorkaroundForErratum58();
       void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
       void PrepareRx(const volatile uint32_t bufferAddress, const volatile size_t size);
+      void SetupListChaining();
+      void StartTransfer();
+      void StartSegment();
+      void StartReceive();
+      void EnableListChaining(size_t chunkCount);
+      void DisableListChaining();
+      static size_t ListChunkSize(size_t size);
 
       NRF_SPIM_Type* spiBaseAddress;
       uint8_t pinCsn;
@@ -59,9 +111,34 @@ namespace Pinetime {
 
       volatile uint32_t currentBufferAddr = 0;
       volatile size_t currentBufferSize = 0;
+      const Segment* volatile currentSegment = nullptr;
+      volatile size_t segmentsLeft = 0;
+      uint8_t pinDataCommand;
+      // Data phase of an asynchronous read, started once the command has been sent
+      static constexpr size_t maxReadCommandSize = 5;
+      uint8_t readCommand[maxReadCommandSize];
+      uint8_t* volatile readBuffer = nullptr;
+      volatile size_t readSize = 0;
+      volatile bool readActive = false;
+      volatile bool receiving = false;
+      // Called from the SPIM interrupt once the last byte of an asynchronous write has been sent
+      TransactionDoneCallback transactionDone = nullptr;
+      void* transactionDoneContext = nullptr;
       SemaphoreHandle_t mutex = nullptr;
       static constexpr nrf_ppi_channel_t workaroundPpi = NRF_PPI_CHANNEL0;
       bool workaroundActive = false;
+
+      // EasyDMA can only send 255 bytes at once. Larger buffers are sent in ArrayList mode: PPI restarts
+      // the SPIM on each END event while TIMER3 counts them. The SPIM interrupts are disabled meanwhile, only the
+      // TIMER3 compare on the last END raises an interrupt.
+      static constexpr size_t maxChunkSize = 255;
+      static constexpr nrf_ppi_channel_t listRestartPpi = NRF_PPI_CHANNEL6;
+      static constexpr nrf_ppi_channel_t listCountPpi = NRF_PPI_CHANNEL7;
+      static constexpr nrf_ppi_channel_t listStopPpi = NRF_PPI_CHANNEL8;
+      static constexpr nrf_ppi_channel_group_t listPpiGroup = NRF_PPI_CHANNEL_GROUP0;
+      bool listActive = false;
+
+      Statistics statistics;
     };
   }
 }
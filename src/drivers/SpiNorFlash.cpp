@@ -3,6 +3,7 @@
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
 #include "drivers/Spi.h"
+#include <task.h>
 
 using namespace Pinetime::Drivers;
 
@@ -10,6 +11,9 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (mutex == nullptr) {
+    mutex = xSemaphoreCreateMutex();
+  }
   device_id = ReadIdentification();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
@@ -21,8 +25,11 @@ void SpiNorFlash::Uninit() {
 }
 
 void SpiNorFlash::Sleep() {
+  Lock();
+  CompletePendingWrite();
   auto cmd = static_cast<uint8_t>(Commands::DeepPowerDown);
   spi.Write(&cmd, sizeof(uint8_t), nullptr);
+  Unlock();
   NRF_LOG_INFO("[SpiNorFlash] Sleep")
 }
 
@@ -31,8 +38,10 @@ void SpiNorFlash::Wakeup() {
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::ReleaseFromDeepPowerDown), 0x01, 0x02, 0x03};
   uint8_t id = 0;
+  Lock();
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, &id, 1);
   auto devId = device_id = ReadIdentification();
+  Unlock();
   if (devId.type != device_id.type) {
     NRF_LOG_INFO("[SpiNorFlash] ID on Wakeup: Failed");
   } else {
@@ -76,7 +85,43 @@ void SpiNorFlash::Read(uint32_t address, uint8_t* buffer, size_t size) {
                           static_cast<uint8_t>(address >> 16U),
                           static_cast<uint8_t>(address >> 8U),
                           static_cast<uint8_t>(address)};
-  spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+  Lock();
+  CompletePendingWrite();
+  statistics.reads++;
+  statistics.readBytes += size;
+  // The SPI bus can be busy with a display transfer: the calling task waits for a notification instead of polling,
+  // other tasks run while the data is being received. Each transfer notifies the task that started it, several tasks
+  // can read at the same time.
+  if (size == 0 || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ||
+      !spi.ReadAsync(cmd, cmdSize, buffer, size, OnReadDone, xTaskGetCurrentTaskHandle())) {
+    spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, buffer, size);
+    Unlock();
+    return;
+  }
+  // The SPI driver keeps the bus until the end of the transfer, the next command is sent after it
+  Unlock();
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
+
+bool SpiNorFlash::ReadAsync(uint32_t address, uint8_t* buffer, size_t size, ReadDoneCallback readDone, void* context) {
+  static constexpr uint8_t cmdSize = 4;
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::Read),
+                          static_cast<uint8_t>(address >> 16U),
+                          static_cast<uint8_t>(address >> 8U),
+                          static_cast<uint8_t>(address)};
+  Lock();
+  CompletePendingWrite();
+  statistics.reads++;
+  statistics.readBytes += size;
+  bool started = spi.ReadAsync(cmd, cmdSize, buffer, size, readDone, context);
+  Unlock();
+  return started;
+}
+
+void SpiNorFlash::OnReadDone(void* task) {
+  BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+  vTaskNotifyGiveFromISR(static_cast<TaskHandle_t>(task), &xHigherPriorityTaskWoken);
+  portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
 }
 
 void SpiNorFlash::WriteEnable() {
@@ -85,20 +130,40 @@ void SpiNorFlash::WriteEnable() {
 }
 
 void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
+  Lock();
+  StartSectorErase(sectorAddress);
+  CompletePendingWrite();
+  Unlock();
+}
+
+void SpiNorFlash::SectorEraseAsync(uint32_t sectorAddress) {
+  Lock();
+  StartSectorErase(sectorAddress);
+  Unlock();
+}
+
+void SpiNorFlash::StartSectorErase(uint32_t sectorAddress) {
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::SectorErase),
                           static_cast<uint8_t>(sectorAddress >> 16U),
                           static_cast<uint8_t>(sectorAddress >> 8U),
                           static_cast<uint8_t>(sectorAddress)};
 
+  CompletePendingWrite();
   WriteEnable();
   while (!WriteEnabled())
     vTaskDelay(1);
 
   spi.Read(reinterpret_cast<uint8_t*>(&cmd), cmdSize, nullptr, 0);
+  statistics.erases++;
+  pendingWrite = PendingWrite::Erase;
+}
 
+void SpiNorFlash::WaitForWriteCompletion() {
+  TickType_t start = xTaskGetTickCount();
   while (WriteInProgress())
     vTaskDelay(1);
+  statistics.busyTime += xTaskGetTickCount() - start;
 }
 
 uint8_t SpiNorFlash::ReadSecurityRegister() {
@@ -118,6 +183,8 @@ bool SpiNorFlash::EraseFailed() {
 
 void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
   static constexpr uint8_t cmdSize = 4;
+  Lock();
+  CompletePendingWrite();
 
   size_t len = size;
   uint32_t addr = address;
@@ -136,14 +203,87 @@ void SpiNorFlash::Write(uint32_t address, const uint8_t* buffer, size_t size) {
       vTaskDelay(1);
 
     spi.WriteCmdAndBuffer(cmd, cmdSize, b, toWrite);
+    statistics.programs++;
+    statistics.programBytes += toWrite;
 
-    while (WriteInProgress())
-      vTaskDelay(1);
+    WaitForWriteCompletion();
 
     addr += toWrite;
     b += toWrite;
     len -= toWrite;
   }
+  Unlock();
+}
+
+void SpiNorFlash::ProgramPageAsync(uint32_t address, const uint8_t* buffer, size_t size) {
+  static constexpr uint8_t cmdSize = 4;
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::PageProgram),
+                          static_cast<uint8_t>(address >> 16U),
+                          static_cast<uint8_t>(address >> 8U),
+                          static_cast<uint8_t>(address)};
+  Lock();
+  CompletePendingWrite();
+
+  WriteEnable();
+  while (!WriteEnabled())
+    vTaskDelay(1);
+
+  // The data is sent synchronously: the buffer can be reused as soon as this returns
+  spi.WriteCmdAndBuffer(cmd, cmdSize, buffer, size);
+  statistics.programs++;
+  statistics.programBytes += size;
+  pendingWrite = PendingWrite::Program;
+  Unlock();
+}
+
+bool SpiNorFlash::WaitForPendingWrite() {
+  Lock();
+  bool success = CompletePendingWrite();
+  Unlock();
+  return success;
+}
+
+bool SpiNorFlash::CompletePendingWrite() {
+  if (pendingWrite == PendingWrite::None) {
+    return true;
+  }
+  PendingWrite write = pendingWrite;
+  pendingWrite = PendingWrite::None;
+  WaitForWriteCompletion();
+  bool success = (write == PendingWrite::Program) ? !ProgramFailed() : !EraseFailed();
+  if (!success) {
+    // Whichever task accessed the flash next, the task that started the write finds out
+    writeFailed = true;
+  }
+  return success;
+}
+
+bool SpiNorFlash::IsBusy() {
+  Lock();
+  bool busy = pendingWrite != PendingWrite::None && WriteInProgress();
+  Unlock();
+  return busy;
+}
+
+bool SpiNorFlash::LastWriteFailed() const {
+  return writeFailed;
+}
+
+void SpiNorFlash::ResetWriteFailure() {
+  writeFailed = false;
+}
+
+void SpiNorFlash::Lock() {
+  // Commands are sent from several tasks (display, BLE, system), a program or an erase is a sequence of them
+  if (mutex != nullptr && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+    xSemaphoreTake(mutex, portMAX_DELAY);
+  }
+}
+
+void SpiNorFlash::Unlock() {
+  if (mutex != nullptr && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+    xSemaphoreGive(mutex);
+  }
 }
 
 SpiNorFlash::Identification SpiNorFlash::GetIdentification() const {
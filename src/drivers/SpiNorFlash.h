@@ -1,6 +1,8 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -24,16 +26,49 @@ namespace Pinetime {
       bool WriteInProgress();
       bool WriteEnabled();
       uint8_t ReadConfigurationRegister();
+      using ReadDoneCallback = void (*)(void* context);
+
+      // Blocks the calling task (not the CPU) until the data has been received
       void Read(uint32_t address, uint8_t* buffer, size_t size);
+      // Starts the transfer and returns, readDone is called from the SPI interrupt once buffer is filled
+      bool ReadAsync(uint32_t address, uint8_t* buffer, size_t size, ReadDoneCallback readDone, void* context);
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
+      // Sends the data of one page (address and size must not cross a page boundary) and returns while the flash
+      // is programming it. The next access to the flash waits for the end of the programming.
+      void ProgramPageAsync(uint32_t address, const uint8_t* buffer, size_t size);
       void WriteEnable();
       void SectorErase(uint32_t sectorAddress);
+      // Starts erasing the sector and returns, the next access to the flash waits for the end of the erase
+      void SectorEraseAsync(uint32_t sectorAddress);
+      // Waits for the program or erase started by ProgramPageAsync() or SectorEraseAsync(), returns false if it failed
+      bool WaitForPendingWrite();
+      // A program or erase started by ProgramPageAsync() or SectorEraseAsync() failed since ResetWriteFailure(). Any
+      // access to the flash can complete them, possibly from another task: the failure is kept until it is reset.
+      bool LastWriteFailed() const;
+      void ResetWriteFailure();
+      // True while the program or erase started by ProgramPageAsync() or SectorEraseAsync() is running
+      bool IsBusy();
       uint8_t ReadSecurityRegister();
       bool ProgramFailed();
       bool EraseFailed();
 
       Identification GetIdentification() const;
 
+      struct Statistics {
+        // Data reads, page programs and sector erases, with the bytes they moved over SPI
+        uint32_t reads = 0;
+        uint32_t readBytes = 0;
+        uint32_t programs = 0;
+        uint32_t programBytes = 0;
+        uint32_t erases = 0;
+        // Time spent waiting for the flash to complete programs and erases
+        TickType_t busyTime = 0;
+      };
+
+      const Statistics& GetStatistics() const {
+        return statistics;
+      }
+
       void Init();
       void Uninit();
 
@@ -42,6 +77,12 @@ namespace Pinetime {
 
     private:
       Identification ReadIdentification();
+      void WaitForWriteCompletion();
+      void StartSectorErase(uint32_t sectorAddress);
+      bool CompletePendingWrite();
+      void Lock();
+      void Unlock();
+      static void OnReadDone(void* task);
 
       enum class Commands : uint8_t {
         PageProgram = 0x02,
@@ -59,6 +100,12 @@ namespace Pinetime {
 
       Spi& spi;
       Identification device_id;
+      enum class PendingWrite : uint8_t { None, Program, Erase };
+      PendingWrite pendingWrite = PendingWrite::None;
+      bool writeFailed = false;
+      // Held during each command sequence, and while a pending write is completed
+      SemaphoreHandle_t mutex = nullptr;
+      Statistics statistics;
     };
   }
 }
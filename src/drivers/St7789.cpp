@@ -116,8 +116,17 @@ void St7789::SleepIn() {
 
 void St7789::PixelFormat() {
   WriteCommand(static_cast<uint8_t>(Commands::PixelFormat));
-  // 65K colours, 16-bit per pixel
-  WriteData(0x55);
+  // 65K colours, 16-bit per pixel or 4K colours, 12-bit per pixel
+  WriteData(static_cast<uint8_t>(colorFormat));
+}
+
+void St7789::SetColorFormat(ColorFormat format) {
+  if (format == colorFormat) {
+    return;
+  }
+  // The frame memory content is kept, only the interface format changes
+  colorFormat = format;
+  PixelFormat();
 }
 
 void St7789::MemoryDataAccessControl() {
@@ -159,7 +168,7 @@ void St7789::PorchSet() {
     0x03, // Normal mode back porch
     0x01, // Porch control enable
     0xed, // Idle mode front:back porch
-    0xed, // Partial mode front:back porch (partial mode unused but set anyway)
+    0xed, // Partial mode front:back porch
   };
   WriteData(args, sizeof(args));
 }
@@ -178,7 +187,7 @@ void St7789::IdleFrameRateOn() {
   constexpr uint8_t args[] = {
     0x12, // Enable frame rate control for partial/idle mode, 4x frame divider
     0x1e, // Idle mode frame rate
-    0x1e, // Partial mode frame rate (unused)
+    0x1e, // Partial mode frame rate
   };
   WriteData(args, sizeof(args));
 }
@@ -188,7 +197,7 @@ void St7789::IdleFrameRateOff() {
   constexpr uint8_t args[] = {
     0x00, // Disable frame rate control and divider
     0x0a, // Idle mode frame rate (normal)
-    0x0a, // Partial mode frame rate (normal, unused)
+    0x0a, // Partial mode frame rate (normal)
   };
   WriteData(args, sizeof(args));
 }
@@ -237,11 +246,6 @@ void St7789::SetAddrWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
   WriteData(addrWindowArgs, sizeof(addrWindowArgs));
 }
 
-void St7789::WriteToRam(const uint8_t* data, size_t size) {
-  WriteCommand(static_cast<uint8_t>(Commands::WriteToRam));
-  WriteData(data, size);
-}
-
 void St7789::SetVdv() {
   // By default there is a large step from pixel brightness zero to one.
   // After experimenting with VCOMS, VRH and VDV, this was found to produce good results.
@@ -264,12 +268,66 @@ void St7789::VerticalScrollStartAddress(uint16_t line) {
   WriteData(verticalScrollArgs, sizeof(verticalScrollArgs));
 }
 
+void St7789::PartialModeOn(uint16_t startLine, uint16_t endLine) {
+  WriteCommand(static_cast<uint8_t>(Commands::PartialArea));
+  uint8_t args[] = {
+    static_cast<uint8_t>(startLine >> 8), // Start row MSB
+    static_cast<uint8_t>(startLine),      // Start row LSB
+    static_cast<uint8_t>(endLine >> 8),   // End row MSB
+    static_cast<uint8_t>(endLine)         // End row LSB
+  };
+  memcpy(partialAreaArgs, args, sizeof(args));
+  WriteData(partialAreaArgs, sizeof(partialAreaArgs));
+  WriteCommand(static_cast<uint8_t>(Commands::PartialModeOn));
+  NRF_LOG_INFO("[LCD] Partial mode");
+}
+
+void St7789::PartialModeOff() {
+  NormalModeOn();
+}
+
 void St7789::Uninit() {
 }
 
-void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
-  SetAddrWindow(x, y, x + width - 1, y + height - 1);
-  WriteToRam(data, size);
+St7789::DrawCommandList&
+St7789::PrepareDrawCommandList(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* data, size_t size) {
+  DrawCommandList& list = drawCommandLists[nextDrawCommandList];
+  nextDrawCommandList = (nextDrawCommandList + 1) % drawCommandLists.size();
+
+  list.columnAddressSet = static_cast<uint8_t>(Commands::ColumnAddressSet);
+  list.columnArgs[0] = static_cast<uint8_t>(x0 >> 8); // x start MSB
+  list.columnArgs[1] = static_cast<uint8_t>(x0);      // x start LSB
+  list.columnArgs[2] = static_cast<uint8_t>(x1 >> 8); // x end MSB
+  list.columnArgs[3] = static_cast<uint8_t>(x1);      // x end LSB
+  list.rowAddressSet = static_cast<uint8_t>(Commands::RowAddressSet);
+  list.rowArgs[0] = static_cast<uint8_t>(y0 >> 8); // y start MSB
+  list.rowArgs[1] = static_cast<uint8_t>(y0);      // y start LSB
+  list.rowArgs[2] = static_cast<uint8_t>(y1 >> 8); // y end MSB
+  list.rowArgs[3] = static_cast<uint8_t>(y1);      // y end LSB
+  list.writeToRam = static_cast<uint8_t>(Commands::WriteToRam);
+
+  list.segments = {{
+    {&list.columnAddressSet, 1, true},
+    {list.columnArgs, sizeof(list.columnArgs), false},
+    {&list.rowAddressSet, 1, true},
+    {list.rowArgs, sizeof(list.rowArgs), false},
+    {&list.writeToRam, 1, true},
+    {data, size, false},
+  }};
+  return list;
+}
+
+void St7789::DrawBuffer(uint16_t x,
+                        uint16_t y,
+                        uint16_t width,
+                        uint16_t height,
+                        const uint8_t* data,
+                        size_t size,
+                        TransferDoneCallback transferDone,
+                        void* transferDoneContext) {
+  // The pixel data is sent asynchronously: it must stay valid until transferDone is called
+  const DrawCommandList& list = PrepareDrawCommandList(x, y, x + width - 1, y + height - 1, data, size);
+  spi.WriteSegments(pinDataCommand, list.segments.data(), list.segments.size(), transferDone, transferDoneContext);
 }
 
 void St7789::HardwareReset() {
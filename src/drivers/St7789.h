@@ -1,9 +1,11 @@
 #pragma once
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 
 #include <FreeRTOS.h>
+#include "drivers/SpiMaster.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -11,6 +13,15 @@ namespace Pinetime {
 
     class St7789 {
     public:
+      // Invoked from interrupt context once the pixel data passed to DrawBuffer() has been sent to the panel
+      using TransferDoneCallback = SpiMaster::TransactionDoneCallback;
+
+      // Format of the pixel data passed to DrawBuffer()
+      enum class ColorFormat : uint8_t {
+        Rgb444 = 0x53, // 4K colours, 2 pixels packed in 3 bytes
+        Rgb565 = 0x55, // 65K colours, 2 bytes per pixel
+      };
+
       explicit St7789(Spi& spi, uint8_t pinDataCommand, uint8_t pinReset);
       St7789(const St7789&) = delete;
       St7789& operator=(const St7789&) = delete;
@@ -22,10 +33,26 @@ namespace Pinetime {
 
       void VerticalScrollStartAddress(uint16_t line);
 
-      void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+      void SetColorFormat(ColorFormat format);
+
+      ColorFormat GetColorFormat() const {
+        return colorFormat;
+      }
+
+      void DrawBuffer(uint16_t x,
+                      uint16_t y,
+                      uint16_t width,
+                      uint16_t height,
+                      const uint8_t* data,
+                      size_t size,
+                      TransferDoneCallback transferDone = nullptr,
+                      void* transferDoneContext = nullptr);
 
       void LowPowerOn();
       void LowPowerOff();
+      // Only drives the lines from startLine to endLine (frame memory lines, wraps around if startLine > endLine)
+      void PartialModeOn(uint16_t startLine, uint16_t endLine);
+      void PartialModeOff();
       void Sleep();
       void Wakeup();
 
@@ -34,6 +61,7 @@ namespace Pinetime {
       uint8_t pinDataCommand;
       uint8_t pinReset;
       uint8_t verticalScrollingStartAddress = 0;
+      ColorFormat colorFormat = ColorFormat::Rgb565;
       bool sleepIn;
       TickType_t lastSleepExit;
 
@@ -47,7 +75,6 @@ namespace Pinetime {
       void MemoryDataAccessControl();
       void DisplayInversionOn();
       void NormalModeOn();
-      void WriteToRam(const uint8_t* data, size_t size);
       void IdleModeOn();
       void IdleModeOff();
       void FrameRateNormalSet();
@@ -69,6 +96,7 @@ namespace Pinetime {
         SoftwareReset = 0x01,
         SleepIn = 0x10,
         SleepOut = 0x11,
+        PartialModeOn = 0x12,
         NormalModeOn = 0x13,
         DisplayInversionOn = 0x21,
         DisplayOff = 0x28,
@@ -76,6 +104,7 @@ namespace Pinetime {
         ColumnAddressSet = 0x2a,
         RowAddressSet = 0x2b,
         WriteToRam = 0x2c,
+        PartialArea = 0x30,
         MemoryDataAccessControl = 0x36,
         VerticalScrollDefinition = 0x33,
         VerticalScrollStartAddress = 0x37,
@@ -99,6 +128,23 @@ namespace Pinetime {
 
       uint8_t addrWindowArgs[4];
       uint8_t verticalScrollArgs[2];
+      uint8_t partialAreaArgs[4];
+
+      // Address window set followed by the RAM write, sent by DrawBuffer() as a single SPI transaction.
+      // The bytes must live in RAM as EasyDMA cannot read from flash.
+      struct DrawCommandList {
+        uint8_t columnAddressSet;
+        uint8_t columnArgs[4];
+        uint8_t rowAddressSet;
+        uint8_t rowArgs[4];
+        uint8_t writeToRam;
+        std::array<SpiMaster::Segment, 6> segments;
+      };
+
+      // The previous list may still be in flight while the next one is prepared
+      std::array<DrawCommandList, 2> drawCommandLists;
+      uint8_t nextDrawCommandList = 0;
+      DrawCommandList& PrepareDrawCommandList(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, const uint8_t* data, size_t size);
     };
   }
 }
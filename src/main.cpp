@@ -212,6 +212,16 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
   }
 }
 
+/* Counts the chunks of SPIM transfers sent in EasyDMA list mode, see SpiMaster */
+extern "C" {
+void TIMER3_IRQHandler(void) {
+  if (NRF_TIMER3->EVENTS_COMPARE[1] == 1) {
+    NRF_TIMER3->EVENTS_COMPARE[1] = 0;
+    spi.OnEndEvent();
+  }
+}
+}
+
 static void (*radio_isr_addr)();
 static void (*rng_isr_addr)();
 static void (*rtc0_isr_addr)();
@@ -72,6 +72,13 @@ void SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQHandler(void) {
     NRF_SPIM0->EVENTS_STOPPED = 0;
   }
 }
+
+void TIMER3_IRQHandler(void) {
+  if (NRF_TIMER3->EVENTS_COMPARE[1] == 1) {
+    NRF_TIMER3->EVENTS_COMPARE[1] = 0;
+    spi.OnEndEvent();
+  }
+}
 }
 
 void RefreshWatchdog() {
@@ -4,17 +4,60 @@ import io
 import sys
 import json
 import shutil
+import zlib
+import struct
 import typing
 import os.path
 import argparse
 import subprocess
 from zipfile import ZipFile
 
+# Pack of all the resources with an index, see src/components/fs/ResourceStore.h
+PACK_FILENAME = 'resources.pack'
+PACK_PATH = '/' + PACK_FILENAME
+PACK_MAGIC = b'ITRP'
+PACK_VERSION = 1
+PACK_MAX_RESOURCES = 24
+PACK_HEADER_FORMAT = '<4sHHII'
+PACK_ENTRY_FORMAT = '<IIII'
+
+def resource_id(path):
+    # FNV-1a hash of the path, as ResourceStore::Id()
+    h = 2166136261
+    for byte in path.encode('utf-8'):
+        h = ((h ^ byte) * 16777619) & 0xFFFFFFFF
+    return h
+
+def build_pack(resources):
+    """resources: list of (target path, file content)"""
+    if len(resources) > PACK_MAX_RESOURCES:
+        sys.exit(f'Error: the resource pack can contain at most {PACK_MAX_RESOURCES} resources.')
+
+    entries = sorted((resource_id(path), path, content) for path, content in resources)
+    for previous, current in zip(entries, entries[1:]):
+        if previous[0] == current[0]:
+            sys.exit(f'Error: {previous[1]} and {current[1]} have the same resource id.')
+
+    offset = struct.calcsize(PACK_HEADER_FORMAT) + len(entries) * struct.calcsize(PACK_ENTRY_FORMAT)
+    index = b''
+    data = b''
+    for rid, path, content in entries:
+        padding = (-offset) % 4
+        data += b'\0' * padding
+        offset += padding
+        index += struct.pack(PACK_ENTRY_FORMAT, rid, offset, len(content), zlib.crc32(content))
+        data += content
+        offset += len(content)
+
+    header = struct.pack(PACK_HEADER_FORMAT, PACK_MAGIC, PACK_VERSION, len(entries), offset, zlib.crc32(index))
+    return header + index + data
+
 def main():
     ap = argparse.ArgumentParser(description='auto generate LVGL font files from fonts')
     ap.add_argument('--config', '-c', type=str, action='append', help='config file to use')
     ap.add_argument('--obsolete', type=str, help='List of obsolete files')
     ap.add_argument('--output', type=str, help='output file name')
+    ap.add_argument('--version', type=str, required=True, help='version of InfiniTime the package is built for')
     args = ap.parse_args()
 
     for config_file in args.config:
@@ -31,7 +74,7 @@ def main():
             sys.exit(f'Error: the "obsolete" file {args.obsolete} is not accessible (permissions?).')
 
     zf = ZipFile(args.output, mode='w')
-    resource_files = []
+    pack_resources = []
 
     for config_file in args.config:
         with open(config_file, 'r') as fd:
@@ -40,22 +83,29 @@ def main():
         resource_names = set(data.keys())
         for name in resource_names:
             resource = data[name]
-            resource_files.append({
-                "filename": name+'.bin',
-                "path": resource['target_path'] + name+'.bin'
-            })
-
             path = name + '.bin'
             if not os.path.exists(path):
                 path = os.path.join(os.path.dirname(sys.argv[0]), path)
-            zf.write(path)
+            with open(path, 'rb') as fd:
+                pack_resources.append((resource['target_path'] + name + '.bin', fd.read()))
+
+    # Only the pack is installed: the package matches the version of the firmware, which reads the resources from the
+    # pack. The separate files installed by older packages are deleted, they would double the space used on the flash.
+    with open(PACK_FILENAME, 'wb') as fd:
+        fd.write(build_pack(pack_resources))
+    zf.write(PACK_FILENAME)
+    resource_files = [{
+        "filename": PACK_FILENAME,
+        "path": PACK_PATH
+    }]
 
     if args.obsolete:
         obsolete_file_path = os.path.join(os.path.dirname(sys.argv[0]), args.obsolete)
         with open(obsolete_file_path, 'r') as fd:
             obsolete_data = json.load(fd)
     else:
-        obsolete_data = {}
+        obsolete_data = []
+    obsolete_data += [{"path": path, "since": args.version} for path in sorted(path for path, _ in pack_resources)]
     output = {
         'resources': resource_files,
         'obsolete_files': obsolete_data
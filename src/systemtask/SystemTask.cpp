@@ -5,6 +5,7 @@
 #include "BootloaderVersion.h"
 #include "components/battery/BatteryController.h"
 #include "components/ble/BleController.h"
+#include "components/heartrate/HeartRateController.h"
 #include "displayapp/TouchEvents.h"
 #include "drivers/Cst816s.h"
 #include "drivers/St7789.h"
@@ -243,6 +244,7 @@ void SystemTask::Work() {
         case Messages::BleFirmwareUpdateStarted:
           GoToRunning();
           wakeLocksHeld++;
+          nimbleController.ConnectionActivityStarted(Pinetime::Controllers::NimbleController::ConnectionActivities::FirmwareUpdate);
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::BleFirmwareUpdateStarted);
           break;
         case Messages::BleFirmwareUpdateFinished:
@@ -250,16 +252,19 @@ void SystemTask::Work() {
             NVIC_SystemReset();
           }
           wakeLocksHeld--;
+          nimbleController.ConnectionActivityStopped(Pinetime::Controllers::NimbleController::ConnectionActivities::FirmwareUpdate);
           break;
         case Messages::StartFileTransfer:
           NRF_LOG_INFO("[systemtask] FS Started");
           GoToRunning();
           wakeLocksHeld++;
+          nimbleController.ConnectionActivityStarted(Pinetime::Controllers::NimbleController::ConnectionActivities::FileTransfer);
           // TODO add intent of fs access icon or something
           break;
         case Messages::StopFileTransfer:
           NRF_LOG_INFO("[systemtask] FS Stopped");
           wakeLocksHeld--;
+          nimbleController.ConnectionActivityStopped(Pinetime::Controllers::NimbleController::ConnectionActivities::FileTransfer);
           // TODO add intent of fs access icon or something
           break;
         case Messages::OnTouchEvent:
@@ -380,6 +385,7 @@ void SystemTask::Work() {
     elapsed = xTaskGetTickCount() - lastStateUpdate;
     if (elapsed >= stateUpdatePeriod) {
       UpdateMotion();
+      PublishDataChanges();
       if (isBleDiscoveryTimerRunning) {
         if (bleDiscoveryTimer == 0) {
           isBleDiscoveryTimerRunning = false;
@@ -467,6 +473,65 @@ void SystemTask::UpdateMotion() {
   }
 }
 
+void SystemTask::PublishDataChanges() {
+  // Nothing is drawn while the display is off, DisplayApp refreshes the whole screen when it wakes up
+  if (state == SystemTaskState::Sleeping) {
+    return;
+  }
+
+  uint8_t changes = Applications::DataSources::None;
+
+  stepCount = motionController.NbSteps();
+  if (stepCount.IsUpdated()) {
+    changes |= Applications::DataSources::Steps;
+  }
+
+  heartRate = heartRateController.HeartRate();
+  heartRateRunning = heartRateController.State() != Controllers::HeartRateController::States::Stopped;
+  if (heartRate.IsUpdated()) {
+    changes |= Applications::DataSources::HeartRate;
+  }
+  if (heartRateRunning.IsUpdated()) {
+    changes |= Applications::DataSources::HeartRate;
+  }
+
+  bleConnected = bleController.IsConnected();
+  bleRadioEnabled = bleController.IsRadioEnabled();
+  if (bleConnected.IsUpdated()) {
+    changes |= Applications::DataSources::Ble;
+  }
+  if (bleRadioEnabled.IsUpdated()) {
+    changes |= Applications::DataSources::Ble;
+  }
+
+  batteryPercentRemaining = batteryController.PercentRemaining();
+  isCharging = batteryController.IsCharging();
+  powerPresent = batteryController.IsPowerPresent();
+  if (batteryPercentRemaining.IsUpdated()) {
+    changes |= Applications::DataSources::Battery;
+  }
+  if (isCharging.IsUpdated()) {
+    changes |= Applications::DataSources::Battery;
+  }
+  if (powerPresent.IsUpdated()) {
+    changes |= Applications::DataSources::Battery;
+  }
+
+  notificationState = notificationManager.AreNewNotificationsAvailable();
+  if (notificationState.IsUpdated()) {
+    changes |= Applications::DataSources::Notifications;
+  }
+
+  currentWeather = nimbleController.weather().Current();
+  if (currentWeather.IsUpdated()) {
+    changes |= Applications::DataSources::Weather;
+  }
+
+  if (changes != Applications::DataSources::None) {
+    displayApp.NotifyDataChanged(changes);
+  }
+}
+
 void SystemTask::HandleButtonAction(Controllers::ButtonActions action) {
   if (IsSleeping()) {
     return;
@@ -31,6 +31,8 @@
 
 #include "drivers/Watchdog.h"
 #include "systemtask/Messages.h"
+#include "displayapp/DataSources.h"
+#include "utility/DirtyValue.h"
 
 extern std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> NoInit_BackUpTime;
 
@@ -142,9 +144,22 @@ namespace Pinetime {
       void GoToRunning();
       void GoToSleep();
       void UpdateMotion();
+      void PublishDataChanges();
       static constexpr TickType_t batteryMeasurementPeriod = pdMS_TO_TICKS(10 * 60 * 1000);
 
       SystemMonitor monitor;
+
+      // Last values published to DisplayApp, see PublishDataChanges()
+      Utility::DirtyValue<uint32_t> stepCount {};
+      Utility::DirtyValue<uint8_t> heartRate {};
+      Utility::DirtyValue<bool> heartRateRunning {};
+      Utility::DirtyValue<bool> bleConnected {};
+      Utility::DirtyValue<bool> bleRadioEnabled {};
+      Utility::DirtyValue<uint8_t> batteryPercentRemaining {};
+      Utility::DirtyValue<bool> isCharging {};
+      Utility::DirtyValue<bool> powerPresent {};
+      Utility::DirtyValue<bool> notificationState {};
+      Utility::DirtyValue<std::optional<Controllers::SimpleWeatherService::CurrentWeather>> currentWeather {};
     };
   }
 }
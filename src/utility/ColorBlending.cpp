@@ -0,0 +1,116 @@
+#include "utility/ColorBlending.h"
+
+// Can be set on the command line to build either path for the host (tools/host_checks.py)
+#ifndef COLOR_BLENDING_USE_DSP
+  #if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+    #define COLOR_BLENDING_USE_DSP 1
+  #else
+    #define COLOR_BLENDING_USE_DSP 0
+  #endif
+#endif
+
+#if COLOR_BLENDING_USE_DSP
+  #include <nrf.h>
+#endif
+
+namespace {
+  constexpr uint32_t DivideBy255(uint32_t value) {
+    // Same approximation as LV_MATH_UDIV255(), exact for the range of a weighted channel sum
+    return (value * 0x8081U) >> 23U;
+  }
+
+  constexpr uint16_t Swap(uint16_t pixel) {
+    return static_cast<uint16_t>((pixel >> 8U) | (pixel << 8U));
+  }
+
+#if COLOR_BLENDING_USE_DSP
+  // weights holds opacity in its low halfword and 255 - opacity in its high halfword:
+  // a single SMLAD computes foreground * opacity + background * (255 - opacity) + 128
+  inline uint32_t MixChannel(uint32_t foreground, uint32_t background, uint32_t weights) {
+    return DivideBy255(__SMLAD(__PKHBT(foreground, background, 16), weights, 128));
+  }
+
+  // Both arguments contain 2 unswapped pixels
+  inline uint32_t MixPixels(uint32_t foreground, uint32_t background, uint32_t weights) {
+    uint32_t result = 0;
+    for (uint32_t shift = 0; shift < 32; shift += 16) {
+      const uint32_t fg = foreground >> shift;
+      const uint32_t bg = background >> shift;
+      const uint32_t r = MixChannel((fg >> 11U) & 0x1fU, (bg >> 11U) & 0x1fU, weights);
+      const uint32_t g = MixChannel((fg >> 5U) & 0x3fU, (bg >> 5U) & 0x3fU, weights);
+      const uint32_t b = MixChannel(fg & 0x1fU, bg & 0x1fU, weights);
+      result |= ((r << 11U) | (g << 5U) | b) << shift;
+    }
+    return result;
+  }
+#endif
+
+  uint16_t MixPixel(uint16_t foreground, uint16_t background, uint32_t opacity) {
+    const uint32_t fg = Swap(foreground);
+    const uint32_t bg = Swap(background);
+    const uint32_t inverse = 255U - opacity;
+    const uint32_t r = DivideBy255(((fg >> 11U) & 0x1fU) * opacity + ((bg >> 11U) & 0x1fU) * inverse + 128U);
+    const uint32_t g = DivideBy255(((fg >> 5U) & 0x3fU) * opacity + ((bg >> 5U) & 0x3fU) * inverse + 128U);
+    const uint32_t b = DivideBy255((fg & 0x1fU) * opacity + (bg & 0x1fU) * inverse + 128U);
+    return Swap(static_cast<uint16_t>((r << 11U) | (g << 5U) | b));
+  }
+}
+
+void Pinetime::Utility::FillRgb565(uint16_t* dest, size_t pixelCount, uint16_t color) {
+  if (pixelCount == 0) {
+    return;
+  }
+  if ((reinterpret_cast<uintptr_t>(dest) & 0x3U) != 0) {
+    *dest++ = color;
+    pixelCount--;
+  }
+
+  const uint32_t pair = static_cast<uint32_t>(color) | (static_cast<uint32_t>(color) << 16U);
+  auto* words = reinterpret_cast<uint32_t*>(dest);
+  size_t wordCount = pixelCount / 2;
+  for (; wordCount >= 4; wordCount -= 4) {
+    words[0] = pair;
+    words[1] = pair;
+    words[2] = pair;
+    words[3] = pair;
+    words += 4;
+  }
+  while (wordCount-- > 0) {
+    *words++ = pair;
+  }
+
+  if ((pixelCount % 2) != 0) {
+    *reinterpret_cast<uint16_t*>(words) = color;
+  }
+}
+
+void Pinetime::Utility::BlendRgb565(uint16_t* dest, const uint16_t* src, size_t pixelCount, uint8_t opacity) {
+#if COLOR_BLENDING_USE_DSP
+  if (pixelCount > 0 && (reinterpret_cast<uintptr_t>(dest) & 0x3U) != 0) {
+    *dest = MixPixel(*src, *dest, opacity);
+    dest++;
+    src++;
+    pixelCount--;
+  }
+
+  const uint32_t weights = static_cast<uint32_t>(opacity) | ((255U - opacity) << 16U);
+  auto* destWords = reinterpret_cast<uint32_t*>(dest);
+  for (size_t i = 0; i < pixelCount / 2; i++) {
+    // src is not necessarily word aligned, the M4 handles unaligned LDR
+    uint32_t foreground;
+    __builtin_memcpy(&foreground, src, sizeof(foreground));
+    src += 2;
+    // REV16 swaps the bytes of both pixels at once
+    *destWords = __REV16(MixPixels(__REV16(foreground), __REV16(*destWords), weights));
+    destWords++;
+  }
+  dest = reinterpret_cast<uint16_t*>(destWords);
+  if ((pixelCount % 2) != 0) {
+    *dest = MixPixel(*src, *dest, opacity);
+  }
+#else
+  for (size_t i = 0; i < pixelCount; i++) {
+    dest[i] = MixPixel(src[i], dest[i], opacity);
+  }
+#endif
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Utility {
+    // Pixel kernels used by LVGL's GPU callbacks. Pixels are RGB565, byte swapped (LV_COLOR_16_SWAP).
+    // On the Cortex-M4 they use the DSP extension, elsewhere a portable C implementation with identical results.
+
+    // Sets pixelCount pixels to color, using word-aligned 2-pixel stores.
+    void FillRgb565(uint16_t* dest, size_t pixelCount, uint16_t color);
+
+    // dest = src * opacity + dest * (255 - opacity) for each pixel, rounded like lv_color_mix().
+    void BlendRgb565(uint16_t* dest, const uint16_t* src, size_t pixelCount, uint8_t opacity);
+  }
+}
@@ -0,0 +1,27 @@
+#include "utility/ColorPacking.h"
+
+size_t Pinetime::Utility::PackRgb444(uint8_t* data, size_t pixelCount) {
+  // The output is always behind the input, so the buffer can be packed in place
+  const uint8_t* in = data;
+  uint8_t* out = data;
+
+  for (size_t i = 1; i < pixelCount; i += 2) {
+    const uint16_t p0 = static_cast<uint16_t>(in[0] << 8 | in[1]);
+    const uint16_t p1 = static_cast<uint16_t>(in[2] << 8 | in[3]);
+    in += 4;
+    // R0 G0 | B0 R1 | G1 B1
+    out[0] = static_cast<uint8_t>(((p0 >> 8) & 0xf0) | ((p0 >> 7) & 0x0f));
+    out[1] = static_cast<uint8_t>(((p0 << 3) & 0xf0) | (p1 >> 12));
+    out[2] = static_cast<uint8_t>(((p1 >> 3) & 0xf0) | ((p1 >> 1) & 0x0f));
+    out += 3;
+  }
+
+  if ((pixelCount % 2) != 0) {
+    const uint16_t p = static_cast<uint16_t>(in[0] << 8 | in[1]);
+    out[0] = static_cast<uint8_t>(((p >> 8) & 0xf0) | ((p >> 7) & 0x0f));
+    out[1] = static_cast<uint8_t>((p << 3) & 0xf0);
+    out += 2;
+  }
+
+  return static_cast<size_t>(out - data);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Utility {
+    // Converts RGB565 pixels (byte swapped, as rendered by LVGL with LV_COLOR_16_SWAP) to packed RGB444:
+    // 2 pixels in 3 bytes, each colour channel truncated to its 4 most significant bits.
+    // The conversion is done in place. Returns the size of the packed data in bytes.
+    // When pixelCount is odd, the last pixel is sent in 2 bytes whose last nibble is ignored by the display.
+    size_t PackRgb444(uint8_t* data, size_t pixelCount);
+  }
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Utility {
+    // CRC-32 (IEEE 802.3, same as zlib.crc32() in Python). Pass the previous result as crc to process data in parts
+    uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+  }
+}
@@ -0,0 +1,59 @@
+#include "utility/Lzss.h"
+
+using namespace Pinetime::Utility;
+
+LzssDecoder::LzssDecoder(const uint8_t* window, OutputCallback output, void* context)
+  : window {window}, output {output}, context {context} {
+}
+
+void LzssDecoder::Reset() {
+  position = 0;
+  controlBits = 0;
+  tokenPending = false;
+}
+
+bool LzssDecoder::Decode(const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    uint8_t value = data[i];
+    if (controlBits == 0) {
+      control = value;
+      controlBits = 8;
+      continue;
+    }
+
+    if ((control & 0x01u) != 0) {
+      if (!Output(value)) {
+        return false;
+      }
+    } else if (!tokenPending) {
+      tokenLow = value;
+      tokenPending = true;
+      continue;
+    } else {
+      tokenPending = false;
+      uint16_t token = tokenLow | (value << 8u);
+      size_t distance = (token & (windowSize - 1)) + 1;
+      size_t length = (token >> windowBits) + minMatch;
+      if (distance > position) {
+        return false;
+      }
+      // Byte by byte: the match can overlap the bytes it produces
+      for (size_t j = 0; j < length; j++) {
+        if (!Output(window[(position - distance) % windowSize])) {
+          return false;
+        }
+      }
+    }
+    control >>= 1u;
+    controlBits--;
+  }
+  return true;
+}
+
+bool LzssDecoder::Output(uint8_t value) {
+  if (!output(context, value)) {
+    return false;
+  }
+  position++;
+  return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Utility {
+    // Decoder of the LZSS variant of the compressed DFU images (see tools/dfu_compress.py). The data can be given in
+    // parts of any size: a compressed item split between two calls to Decode() is completed by the second one.
+    //
+    // The decoder doesn't store the output. Each byte is given to the output callback, which must store the byte at
+    // position % windowSize of window (position counted from Reset()) before returning: matches are copied from it.
+    class LzssDecoder {
+    public:
+      static constexpr uint8_t windowBits = 10;
+      static constexpr size_t windowSize = 1 << windowBits;
+      static constexpr size_t minMatch = 3;
+
+      // Returns false to stop decoding
+      using OutputCallback = bool (*)(void* context, uint8_t value);
+
+      LzssDecoder(const uint8_t* window, OutputCallback output, void* context);
+
+      void Reset();
+      // Returns false if the data refers to bytes before the start of the output, or if the callback returned false
+      bool Decode(const uint8_t* data, size_t size);
+
+    private:
+      const uint8_t* window;
+      OutputCallback output;
+      void* context;
+      // Bytes output since Reset()
+      size_t position = 0;
+      // Compressed items can be split between parts
+      uint8_t control = 0;
+      uint8_t controlBits = 0;
+      uint8_t tokenLow = 0;
+      bool tokenPending = false;
+
+      bool Output(uint8_t value);
+    };
+  }
+}
@@ -0,0 +1,20 @@
+#!/bin/sh
+
+# Self-tests of the tools and host checks of the firmware code, they build parts of the firmware for the host
+# (see tools/host_build.py).
+# Fails if there is no C++ compiler when CI or CXX is set.
+
+set -e
+
+cd "$(dirname "$0")/.."
+
+for tool in tools/dfu_compress.py tools/ble_bulk_framing.py
+do
+  echo "::group::$tool"
+  python3 "$tool" --self-test
+  echo "::endgroup::"
+done
+
+echo "::group::tools/host_checks.py"
+python3 tools/host_checks.py
+echo "::endgroup::"
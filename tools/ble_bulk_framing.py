@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+
+# Framing of the L2CAP channel of InfiniTime (see BulkTransport in src/components/ble/BulkTransport.h).
+#
+# The companion app opens an LE credit based channel on PSM 0x0080. Each SDU carries one or more frames, a frame is
+# never split between SDUs:
+#
+#   header   uint8 service (1: FS, 2: DFU), uint8 reserved (0), uint16 length of the payload. Little endian.
+#   payload  FS: a command of the FS service (same format as over GATT), its responses come back on the channel.
+#            DFU: data of the firmware image, in the Data state of the DFU service.
+#
+# InfiniTime accepts SDUs of up to 512 bytes, and sends SDUs up to the smallest of its MTU and the MTU of the app.
+# These functions can be used by the companion apps. Use --self-test to check them through a simulated channel
+# (segmentation in LE frames and credits), as a loopback between the app and the watch. The self-test also builds the
+# framing of the firmware (src/components/ble/BulkFraming.cpp) for the host with tools/host/bulk_framing.cpp, and checks
+# that it reads the same frames from the SDUs (see tools/host_build.py).
+
+import argparse
+import os
+import random
+import struct
+import sys
+import tempfile
+
+import host_build
+
+PSM = 0x0080
+MTU = 512
+HEADER = struct.Struct("<BBH")
+SERVICE_FS = 0x01
+SERVICE_DFU = 0x02
+
+
+def encode_frame(service, payload):
+    if len(payload) > 0xFFFF:
+        raise ValueError("payload too large")
+    return HEADER.pack(service, 0, len(payload)) + bytes(payload)
+
+
+def pack_frames(frames, mtu=MTU):
+    """Packs (service, payload) frames into as few SDUs as possible"""
+    sdus = []
+    sdu = bytearray()
+    for service, payload in frames:
+        frame = encode_frame(service, payload)
+        if len(frame) > mtu:
+            raise ValueError("frame larger than the MTU")
+        if len(sdu) + len(frame) > mtu:
+            sdus.append(bytes(sdu))
+            sdu = bytearray()
+        sdu += frame
+    if sdu:
+        sdus.append(bytes(sdu))
+    return sdus
+
+
+def unpack_frames(sdu):
+    """Frames of an SDU. Like InfiniTime, stops at a frame that is truncated"""
+    frames = []
+    offset = 0
+    while offset + HEADER.size <= len(sdu):
+        service, _, length = HEADER.unpack_from(sdu, offset)
+        offset += HEADER.size
+        if length > len(sdu) - offset:
+            break
+        frames.append((service, bytes(sdu[offset:offset + length])))
+        offset += length
+    return frames
+
+
+class Channel:
+    """One direction of an LE credit based channel: SDUs are segmented in LE frames of up to mps bytes (the first
+    one starts with the SDU length), each LE frame uses one credit. The receiver gives the credits of one SDU back
+    when it is ready for the next one, like InfiniTime does."""
+
+    def __init__(self, mtu, mps):
+        self.mtu = mtu
+        self.mps = mps
+        self.credits_per_sdu = (mtu + 2 + mps - 1) // mps
+        self.credits = self.credits_per_sdu
+        self.le_frames = []
+
+    def send(self, sdu):
+        if len(sdu) > self.mtu:
+            raise ValueError("SDU larger than the MTU")
+        data = struct.pack("<H", len(sdu)) + sdu
+        for offset in range(0, len(data), self.mps):
+            if self.credits == 0:
+                return False
+            self.credits -= 1
+            self.le_frames.append(data[offset:offset + self.mps])
+        return True
+
+    def receive(self):
+        data = b"".join(self.le_frames)
+        self.le_frames = []
+        length, = struct.unpack_from("<H", data)
+        if length != len(data) - 2:
+            raise AssertionError("SDU reassembly failed")
+        # Ready for the next SDU
+        self.credits = self.credits_per_sdu
+        return data[2:]
+
+
+def loopback(frames, mtu, mps):
+    """Returns the SDUs received"""
+    channel = Channel(mtu, mps)
+    sdus = []
+    received = []
+    for sdu in pack_frames(frames, mtu):
+        if not channel.send(sdu):
+            raise AssertionError("not enough credits for one SDU")
+        sdus.append(channel.receive())
+        received += unpack_frames(sdus[-1])
+    if received != [(service, bytes(payload)) for service, payload in frames]:
+        raise AssertionError("loopback failed")
+    return sdus
+
+
+def check_host_framing(sdus):
+    """The firmware must read the same frames as unpack_frames(), and detect the same truncated frames"""
+    with tempfile.TemporaryDirectory() as directory:
+        framing = host_build.build(directory, "bulk_framing", ["components/ble/BulkFraming.cpp"])
+        if framing is None:
+            return
+        data = b"".join(struct.pack("<H", len(sdu)) + sdu for sdu in sdus)
+        output = host_build.run(framing, data).stdout
+
+    offset = 0
+    for sdu in sdus:
+        length, truncated = struct.unpack_from("<HB", output, offset)
+        offset += 3
+        frames = unpack_frames(sdu)
+        expected = b"".join(encode_frame(service, payload) for service, payload in frames)
+        # unpack_frames() stops before the leftover bytes: a truncated frame if there is at least a header
+        expected_truncated = len(sdu) - len(expected) >= HEADER.size
+        if output[offset:offset + length] != expected or bool(truncated) != expected_truncated:
+            raise AssertionError("the firmware doesn't read the same frames")
+        offset += length
+    if offset != len(output):
+        raise AssertionError("unexpected output of the firmware framing")
+
+
+def self_test():
+    rng = random.Random(0)
+    max_payload = MTU - HEADER.size
+    cases = [
+        [],
+        [(SERVICE_FS, b"")],
+        [(SERVICE_DFU, bytes(max_payload))],
+        [(SERVICE_FS, bytes([0x50, 0, 1, 0]) + b"/")] * 50,
+        [(rng.choice([SERVICE_FS, SERVICE_DFU]), bytes(rng.getrandbits(8) for _ in range(rng.randrange(max_payload + 1))))
+         for _ in range(200)],
+    ]
+    sdus = []
+    for frames in cases:
+        for mps in (23, 100, 284):
+            sdus += loopback(frames, MTU, mps)
+        sdus += loopback([frame for frame in frames if len(frame[1]) <= 64 - HEADER.size], 64, 23)
+
+    # Frames are packed: 100 small frames fit in a few SDUs
+    if len(pack_frames([(SERVICE_FS, bytes(10))] * 100)) != 3:
+        raise AssertionError("frames not packed")
+    # Truncated frames are dropped, the frames before them are kept
+    sdu = encode_frame(SERVICE_FS, b"abc") + encode_frame(SERVICE_DFU, b"defgh")[:-1]
+    if unpack_frames(sdu) != [(SERVICE_FS, b"abc")]:
+        raise AssertionError("truncated frame")
+    if unpack_frames(encode_frame(SERVICE_FS, b"abc") + b"\x01") != [(SERVICE_FS, b"abc")]:
+        raise AssertionError("trailing byte")
+    for mtu in (MTU, 1):
+        try:
+            pack_frames([(SERVICE_DFU, bytes(MTU))], mtu)
+        except ValueError:
+            continue
+        raise AssertionError("oversized frame")
+
+    # Also feed the firmware with SDUs that end with truncated frames, a few leftover bytes, or random data
+    sdus += [sdu, encode_frame(SERVICE_FS, b"abc") + b"\x01", b"", b"\x01\x00\x00", b"\x02\x00\x01\x00"]
+    sdus += [bytes(rng.getrandbits(8) for _ in range(rng.randrange(MTU + 1))) for _ in range(100)]
+    check_host_framing(sdus)
+    print("Self-test passed ({} cases)".format(len(cases)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Framing of the L2CAP channel of InfiniTime")
+    parser.add_argument("--self-test", action="store_true", help="check the framing through a simulated channel")
+    args = parser.parse_args()
+    if args.self_test:
+        self_test()
+        return
+    parser.print_help()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+
+# Compresses a firmware image for the DFU service of InfiniTime.
+#
+# The compressed image is sent instead of the raw one, InfiniTime decompresses it into the OTA slot as it is
+# received. The format is a small LZSS variant, so that the decoder only needs a 1 KB window:
+#
+#   header   uint32 magic "ITLZ", uint32 size of the image, uint16 CRC of the image (same CRC as the DFU init
+#            packet), uint8 version (1), uint8 log2 of the window size (10). Little endian.
+#   data     groups of one control byte followed by 8 items, one per bit of the control byte (LSB first):
+#              1: a literal byte
+#              0: a match, uint16 little endian: bits 0-9 distance - 1, bits 10-15 length - 3
+#            The data ends when the decompressed size reaches the size of the image.
+#
+# The image is decompressed again after compression and compared to the original (round-trip check).
+# Use --self-test to check the compressor and the decompressor on generated data. The self-test also builds the C++
+# decoder of the firmware (src/utility/Lzss.cpp) for the host with tools/host/lzss_decode.cpp, and checks that it
+# decompresses the same data (see tools/host_build.py).
+
+import argparse
+import os
+import random
+import struct
+import sys
+import tempfile
+
+import host_build
+
+MAGIC = 0x5A4C5449
+VERSION = 1
+WINDOW_BITS = 10
+WINDOW_SIZE = 1 << WINDOW_BITS
+MIN_MATCH = 3
+MAX_MATCH = MIN_MATCH + 63
+# Candidates tried for each position, more is slower and compresses a bit better
+MAX_CHAIN = 256
+
+
+def dfu_crc(data, crc=0xFFFF):
+    """CRC-16/CCITT as computed by DfuService::DfuImage::ComputeCrc()"""
+    for byte in data:
+        crc = ((crc >> 8) | (crc << 8)) & 0xFFFF
+        crc ^= byte
+        crc ^= (crc & 0xFF) >> 4
+        crc ^= (crc << 12) & 0xFFFF
+        crc ^= ((crc & 0xFF) << 5) & 0xFFFF
+    return crc
+
+
+def find_match(data, pos, chains):
+    end = min(len(data), pos + MAX_MATCH)
+    best_length = 0
+    best_distance = 0
+    for candidate in reversed(chains.get(data[pos:pos + MIN_MATCH], [])[-MAX_CHAIN:]):
+        distance = pos - candidate
+        if distance > WINDOW_SIZE:
+            break
+        length = 0
+        while pos + length < end and data[candidate + length] == data[pos + length]:
+            length += 1
+        if length > best_length:
+            best_length = length
+            best_distance = distance
+            if pos + length == end:
+                break
+    return best_length, best_distance
+
+
+def compress(data):
+    out = bytearray(struct.pack("<IIHBB", MAGIC, len(data), dfu_crc(data), VERSION, WINDOW_BITS))
+    chains = {}
+    control_index = 0
+    control_bit = 8
+    pos = 0
+
+    def add_position(position):
+        key = data[position:position + MIN_MATCH]
+        if len(key) == MIN_MATCH:
+            chain = chains.setdefault(key, [])
+            chain.append(position)
+            # Positions out of the window are never used again
+            if len(chain) > 2 * MAX_CHAIN:
+                del chain[:MAX_CHAIN]
+
+    while pos < len(data):
+        if control_bit == 8:
+            control_index = len(out)
+            out.append(0)
+            control_bit = 0
+
+        length, distance = find_match(data, pos, chains)
+        if length >= MIN_MATCH:
+            out += struct.pack("<H", (distance - 1) | ((length - MIN_MATCH) << WINDOW_BITS))
+        else:
+            length = 1
+            out[control_index] |= 1 << control_bit
+            out.append(data[pos])
+        control_bit += 1
+
+        for position in range(pos, pos + length):
+            add_position(position)
+        pos += length
+
+    return bytes(out)
+
+
+def decompress(compressed):
+    magic, size, crc, version, window_bits = struct.unpack_from("<IIHBB", compressed)
+    if magic != MAGIC or version != VERSION or window_bits > WINDOW_BITS:
+        raise ValueError("not a compressed image")
+
+    out = bytearray()
+    pos = struct.calcsize("<IIHBB")
+    while len(out) < size:
+        control = compressed[pos]
+        pos += 1
+        for bit in range(8):
+            if len(out) == size:
+                break
+            if control & (1 << bit):
+                out.append(compressed[pos])
+                pos += 1
+            else:
+                token, = struct.unpack_from("<H", compressed, pos)
+                pos += 2
+                distance = (token & (WINDOW_SIZE - 1)) + 1
+                length = (token >> WINDOW_BITS) + MIN_MATCH
+                if distance > len(out):
+                    raise ValueError("invalid distance")
+                for _ in range(length):
+                    out.append(out[-distance])
+
+    if len(out) != size or dfu_crc(out) != crc:
+        raise ValueError("invalid data")
+    return bytes(out)
+
+
+def round_trip(data):
+    compressed = compress(data)
+    if decompress(compressed) != data:
+        raise AssertionError("round-trip failed")
+    return compressed
+
+
+def self_test():
+    rng = random.Random(0)
+    samples = [
+        b"",
+        b"a",
+        b"ab" * 3,
+        b"\x00" * 5000,
+        bytes(rng.getrandbits(8) for _ in range(3000)),
+        bytes(rng.choice(b"abc") for _ in range(10000)),
+        # Repetitions just inside and just outside of the window
+        bytes(range(256)) * 4 + bytes(range(256)) * 5,
+        bytes(rng.getrandbits(8) for _ in range(WINDOW_SIZE)) * 3,
+        bytes(rng.getrandbits(8) for _ in range(WINDOW_SIZE + 1)) * 3,
+    ]
+    compressed_samples = [round_trip(sample) for sample in samples]
+
+    with tempfile.TemporaryDirectory() as directory:
+        decoder = host_build.build(directory, "lzss_decode", ["utility/Lzss.cpp"])
+        if decoder is not None:
+            for sample, compressed in zip(samples, compressed_samples):
+                if host_build.run(decoder, compressed).stdout != sample:
+                    raise AssertionError("the firmware decoder doesn't decompress the same data")
+            # Corrupted data must be rejected: a match before the start of the image
+            result = host_build.run(decoder, compressed_samples[3][:12] + b"\x00\x00\x00", check=False)
+            if result.returncode == 0:
+                raise AssertionError("the firmware decoder accepted invalid data")
+    print("Self-test passed ({} samples)".format(len(samples)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compress a firmware image for the DFU service of InfiniTime")
+    parser.add_argument("input", nargs="?", help="firmware image (.bin)")
+    parser.add_argument("output", nargs="?", help="compressed image")
+    parser.add_argument("--self-test", action="store_true", help="check compression and decompression, then exit")
+    args = parser.parse_args()
+
+    if args.self_test:
+        self_test()
+        return
+    if args.input is None or args.output is None:
+        parser.error("input and output are required")
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+    compressed = round_trip(data)
+    with open(args.output, "wb") as f:
+        f.write(compressed)
+    print("{}: {} -> {} bytes ({:.1f}%)".format(args.output, len(data), len(compressed), 100.0 * len(compressed) / max(len(data), 1)))
+
+
+if __name__ == "__main__":
+    sys.exit(main())
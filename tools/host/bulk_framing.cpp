@@ -0,0 +1,47 @@
+// Host build of the framing of the L2CAP channel, used by tools/ble_bulk_framing.py --self-test.
+// Reads SDUs on stdin, each one preceded by its uint16 length. For each SDU, the frames are read with
+// BulkFraming::FrameReader and encoded again with BulkFraming::WriteHeader(). The result is written on stdout:
+// uint16 length of the frames, uint8 1 if the SDU ended with a truncated frame, then the frames.
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "components/ble/BulkFraming.h"
+
+using namespace Pinetime::Controllers::BulkFraming;
+
+namespace {
+  bool ReadExactly(uint8_t* buffer, size_t size) {
+    return std::fread(buffer, 1, size, stdin) == size;
+  }
+}
+
+int main() {
+  uint8_t lengthBytes[2];
+  while (ReadExactly(lengthBytes, sizeof(lengthBytes))) {
+    auto length = static_cast<uint16_t>(lengthBytes[0] | (lengthBytes[1] << 8));
+    std::vector<uint8_t> sdu(length);
+    if (!ReadExactly(sdu.data(), length)) {
+      std::fprintf(stderr, "truncated input\n");
+      return 1;
+    }
+
+    FrameReader reader {sdu.data(), length};
+    std::vector<uint8_t> frames;
+    FrameHeader header;
+    uint8_t* payload;
+    while (reader.Next(header, payload)) {
+      size_t offset = frames.size();
+      frames.resize(offset + sizeof(FrameHeader));
+      WriteHeader(frames.data() + offset, header.service, header.length);
+      frames.insert(frames.end(), payload, payload + header.length);
+    }
+
+    uint8_t result[3] = {static_cast<uint8_t>(frames.size()),
+                         static_cast<uint8_t>(frames.size() >> 8),
+                         static_cast<uint8_t>(reader.IsTruncated() ? 1 : 0)};
+    std::fwrite(result, 1, sizeof(result), stdout);
+    std::fwrite(frames.data(), 1, frames.size(), stdout);
+  }
+  return 0;
+}
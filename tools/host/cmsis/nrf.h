@@ -0,0 +1,34 @@
+// Replaces nrf.h when src/utility/ColorBlending.cpp is built for the host with COLOR_BLENDING_USE_DSP=1, so that the
+// DSP path can be checked on any host: the CMSIS intrinsics it uses are the instructions themselves on an Arm host
+// with the DSP extension, and C implementations of the same operations elsewhere.
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+  #include <arm_acle.h>
+
+inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3) {
+  return static_cast<uint32_t>(__smlad(static_cast<int16x2_t>(op1), static_cast<int16x2_t>(op2), static_cast<int32_t>(op3)));
+}
+
+inline uint32_t __REV16(uint32_t value) {
+  return __rev16(value);
+}
+#else
+// Signed multiply of both halfwords, accumulated
+inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t op3) {
+  const int32_t low = static_cast<int16_t>(op1 & 0xffffU) * static_cast<int16_t>(op2 & 0xffffU);
+  const int32_t high = static_cast<int16_t>(op1 >> 16U) * static_cast<int16_t>(op2 >> 16U);
+  return static_cast<uint32_t>(static_cast<int32_t>(op3) + low + high);
+}
+
+// Swaps the bytes of each halfword
+inline uint32_t __REV16(uint32_t value) {
+  return ((value & 0x00ff00ffU) << 8U) | ((value & 0xff00ff00U) >> 8U);
+}
+#endif
+
+// Bottom halfword of arg1, top halfword of arg2 shifted left
+#define __PKHBT(ARG1, ARG2, ARG3) ((((uint32_t) (ARG1)) & 0x0000ffffU) | ((((uint32_t) (ARG2)) << (ARG3)) & 0xffff0000U))
@@ -0,0 +1,155 @@
+// Host check of Utility::FillRgb565() and Utility::BlendRgb565() (src/utility/ColorBlending.cpp), used by
+// tools/host_checks.py, which builds it once for each path of ColorBlending.cpp (COLOR_BLENDING_USE_DSP 0 and 1).
+// The results are compared to a plain loop, and to lv_color_mix() for each pixel (tools/host/lv_color16.h), for
+// destinations and sources that are not word aligned, odd and even pixel counts, and all the opacities. Then both
+// functions and the reference loop are timed on the draw buffer of LittleVgl. Exits with 1 on the first mismatch.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "lv_color16.h"
+#include "utility/ColorBlending.h"
+
+using Pinetime::Utility::BlendRgb565;
+using Pinetime::Utility::FillRgb565;
+
+namespace {
+  constexpr uint8_t opaMax = 250; // LV_OPA_MAX
+  constexpr uint16_t guard = 0xa5a5;
+  constexpr size_t guardSize = 4;
+  constexpr size_t counts[] = {0, 1, 2, 3, 4, 5, 7, 8, 9, 16, 17, 239, 240, 241};
+  constexpr uint8_t opacities[] = {0, 1, 127, 128, 254, opaMax, 255};
+
+  std::mt19937 rng {0};
+
+  std::vector<uint16_t> RandomPixels(size_t count) {
+    std::vector<uint16_t> pixels(count);
+    for (auto& pixel : pixels) {
+      pixel = static_cast<uint16_t>(rng());
+    }
+    return pixels;
+  }
+
+  // Pixels are written at offset (in pixels) from the start of a word aligned buffer, followed by guard pixels
+  std::vector<uint16_t> Place(const std::vector<uint16_t>& pixels, size_t offset) {
+    std::vector<uint16_t> buffer(offset, guard);
+    buffer.insert(buffer.end(), pixels.begin(), pixels.end());
+    buffer.insert(buffer.end(), guardSize, guard);
+    return buffer;
+  }
+
+  bool Matches(const std::vector<uint16_t>& buffer, const std::vector<uint16_t>& expected, size_t offset) {
+    return buffer == Place(expected, offset);
+  }
+
+  bool CheckFill(size_t count, size_t offset) {
+    const auto color = static_cast<uint16_t>(rng());
+    auto buffer = Place(RandomPixels(count), offset);
+    FillRgb565(buffer.data() + offset, count, color);
+    if (!Matches(buffer, std::vector<uint16_t>(count, color), offset)) {
+      std::fprintf(stderr, "FillRgb565: wrong result for %zu pixels at offset %zu\n", count, offset);
+      return false;
+    }
+    return true;
+  }
+
+  std::vector<uint16_t> ReferenceBlend(const std::vector<uint16_t>& dest, const std::vector<uint16_t>& src, uint8_t opacity) {
+    std::vector<uint16_t> result(dest.size());
+    for (size_t i = 0; i < dest.size(); i++) {
+      result[i] = LvColor16::Full(LvColor16::Mix(LvColor16::FromFull(src[i]), LvColor16::FromFull(dest[i]), opacity));
+    }
+    return result;
+  }
+
+  bool CheckBlend(size_t count, size_t destOffset, size_t srcOffset, uint8_t opacity) {
+    const auto dest = RandomPixels(count);
+    const auto src = RandomPixels(count);
+    auto destBuffer = Place(dest, destOffset);
+    const auto srcBuffer = Place(src, srcOffset);
+    BlendRgb565(destBuffer.data() + destOffset, srcBuffer.data() + srcOffset, count, opacity);
+    if (!Matches(destBuffer, ReferenceBlend(dest, src, opacity), destOffset)) {
+      std::fprintf(stderr,
+                   "BlendRgb565: wrong result for %zu pixels, opacity %u, dest offset %zu, src offset %zu\n",
+                   count,
+                   opacity,
+                   destOffset,
+                   srcOffset);
+      return false;
+    }
+    return true;
+  }
+
+  template <typename Function>
+  double NanosecondsPerPixel(size_t pixelCount, int iterations, Function function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+      function();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(pixelCount) * iterations);
+  }
+}
+
+int main() {
+  for (size_t count : counts) {
+    for (size_t offset : {0, 1}) {
+      if (!CheckFill(count, offset)) {
+        return 1;
+      }
+    }
+  }
+
+  for (size_t count : counts) {
+    for (size_t destOffset : {0, 1}) {
+      for (size_t srcOffset : {0, 1}) {
+        for (uint8_t opacity : opacities) {
+          if (!CheckBlend(count, destOffset, srcOffset, opacity)) {
+            return 1;
+          }
+        }
+      }
+    }
+  }
+  for (unsigned opacity = 0; opacity <= 255; opacity++) {
+    if (!CheckBlend(241, opacity % 2, opacity / 2 % 2, static_cast<uint8_t>(opacity))) {
+      return 1;
+    }
+  }
+
+  // Timing, on the host: compare builds against each other, not against the figures measured on the watch
+  constexpr size_t pixelCount = 240 * 4;
+  constexpr int iterations = 10000;
+  auto dest = RandomPixels(pixelCount + 1);
+  const auto src = RandomPixels(pixelCount + 1);
+  uint32_t checksum = 0;
+  const auto fill = NanosecondsPerPixel(pixelCount, iterations, [&]() {
+    FillRgb565(dest.data(), pixelCount, static_cast<uint16_t>(checksum++));
+  });
+  const auto blend = NanosecondsPerPixel(pixelCount, iterations, [&]() {
+    BlendRgb565(dest.data(), src.data(), pixelCount, 128);
+  });
+  const auto blendUnaligned = NanosecondsPerPixel(pixelCount, iterations, [&]() {
+    BlendRgb565(dest.data(), src.data() + 1, pixelCount, 128);
+  });
+  const auto reference = NanosecondsPerPixel(pixelCount, iterations, [&]() {
+    for (size_t i = 0; i < pixelCount; i++) {
+      dest[i] = LvColor16::Full(LvColor16::Mix(LvColor16::FromFull(src[i]), LvColor16::FromFull(dest[i]), 128));
+    }
+  });
+  for (auto pixel : dest) {
+    checksum += pixel;
+  }
+  std::printf("ColorBlending (%s path): fill %.2f, blend %.2f (unaligned src %.2f), lv_color_mix() loop %.2f ns/pixel "
+              "(%zu pixels, %d iterations, checksum %u)\n",
+              COLOR_BLENDING_USE_DSP ? "DSP" : "portable",
+              fill,
+              blend,
+              blendUnaligned,
+              reference,
+              pixelCount,
+              iterations,
+              checksum);
+  return 0;
+}
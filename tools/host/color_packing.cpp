@@ -0,0 +1,110 @@
+// Host check of Utility::PackRgb444() (src/utility/ColorPacking.cpp), used by tools/host_checks.py.
+// Pixels are stored as LVGL does with LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 1 (tools/host/lv_color16.h),
+// packed in place and compared to a reference conversion done from the 8 bit colour channels, one nibble at a time.
+// Then PackRgb444() is timed on the draw buffer of LittleVgl (4 lines). Exits with 1 on the first mismatch.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "lv_color16.h"
+#include "utility/ColorPacking.h"
+
+namespace {
+  struct Rgb {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+  };
+
+  // RGB444 keeps the 4 most significant bits of each channel, packed as a stream of nibbles: R0 G0 B0 R1 G1 B1...
+  // An odd pixel is padded with a 0 nibble.
+  std::vector<uint8_t> Reference(const std::vector<Rgb>& pixels) {
+    std::vector<uint8_t> nibbles;
+    for (const auto& c : pixels) {
+      nibbles.push_back(c.r >> 4);
+      nibbles.push_back(c.g >> 4);
+      nibbles.push_back(c.b >> 4);
+    }
+    if (nibbles.size() % 2 != 0) {
+      nibbles.push_back(0);
+    }
+    std::vector<uint8_t> packed;
+    for (size_t i = 0; i < nibbles.size(); i += 2) {
+      packed.push_back(static_cast<uint8_t>(nibbles[i] << 4 | nibbles[i + 1]));
+    }
+    return packed;
+  }
+
+  bool Check(const std::vector<Rgb>& pixels) {
+    constexpr size_t guardSize = 8;
+    std::vector<uint8_t> buffer(pixels.size() * sizeof(LvColor16::Color) + guardSize, 0xa5);
+    for (size_t i = 0; i < pixels.size(); i++) {
+      const auto color = LvColor16::Make(pixels[i].r, pixels[i].g, pixels[i].b);
+      std::memcpy(buffer.data() + i * sizeof(color), &color, sizeof(color));
+    }
+
+    const auto expected = Reference(pixels);
+    const auto size = Pinetime::Utility::PackRgb444(buffer.data(), pixels.size());
+    const bool sizeMatches = size == expected.size() && size == (pixels.size() * 3 + 1) / 2;
+    if (!sizeMatches || !std::equal(expected.begin(), expected.end(), buffer.begin())) {
+      std::fprintf(stderr, "PackRgb444: wrong result for %zu pixels\n", pixels.size());
+      return false;
+    }
+    for (size_t i = pixels.size() * sizeof(LvColor16::Color); i < buffer.size(); i++) {
+      if (buffer[i] != 0xa5) {
+        std::fprintf(stderr, "PackRgb444: written past the end of %zu pixels\n", pixels.size());
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main() {
+  std::mt19937 rng {0};
+  auto randomColor = [&rng]() {
+    return Rgb {static_cast<uint8_t>(rng()), static_cast<uint8_t>(rng()), static_cast<uint8_t>(rng())};
+  };
+
+  // The byte order of LV_COLOR_16_SWAP: red first, blue last
+  if (!Check({{0xff, 0, 0}}) || !Check({{0, 0xff, 0}}) || !Check({{0, 0, 0xff}}) || !Check({{0xff, 0, 0}, {0, 0, 0xff}})) {
+    return 1;
+  }
+  // Even and odd pixel counts, up to the size of the draw buffer
+  for (size_t count : {0, 1, 2, 3, 4, 5, 6, 7, 31, 32, 33, 239, 240, 241, 960}) {
+    for (int i = 0; i < 10; i++) {
+      std::vector<Rgb> pixels(count);
+      for (auto& pixel : pixels) {
+        pixel = randomColor();
+      }
+      if (!Check(pixels)) {
+        return 1;
+      }
+    }
+  }
+
+  // Timing, on the host: compare builds against each other, not against the figures measured on the watch
+  constexpr size_t pixelCount = 240 * 4;
+  constexpr int iterations = 20000;
+  std::vector<uint8_t> source(pixelCount * sizeof(LvColor16::Color));
+  for (auto& byte : source) {
+    byte = static_cast<uint8_t>(rng());
+  }
+  std::vector<uint8_t> buffer(source.size());
+  size_t checksum = 0;
+  std::chrono::steady_clock::duration elapsed {};
+  for (int i = 0; i < iterations; i++) {
+    std::memcpy(buffer.data(), source.data(), source.size());
+    const auto start = std::chrono::steady_clock::now();
+    checksum += Pinetime::Utility::PackRgb444(buffer.data(), pixelCount) + buffer[i % pixelCount];
+    elapsed += std::chrono::steady_clock::now() - start;
+  }
+  const auto ns = std::chrono::duration<double, std::nano>(elapsed).count();
+  std::printf("PackRgb444: %.2f ns/pixel (%zu pixels, %d iterations, checksum %zu)\n", ns / (pixelCount * iterations), pixelCount,
+              iterations, checksum);
+  return 0;
+}
@@ -0,0 +1,57 @@
+// The parts of lv_color.h of LVGL 7 used by the host checks, for LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 1
+// (src/libs/lv_conf.h). LVGL itself is only built for the nRF52.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace LvColor16 {
+  // lv_color16_t
+  struct Color {
+    uint16_t greenHigh : 3;
+    uint16_t red : 5;
+    uint16_t blue : 5;
+    uint16_t greenLow : 3;
+  };
+  static_assert(sizeof(Color) == 2);
+
+  // LV_COLOR_MAKE()
+  inline Color Make(uint8_t r, uint8_t g, uint8_t b) {
+    Color color {};
+    color.red = r >> 3;
+    color.greenHigh = g >> 5;
+    color.greenLow = (g >> 2) & 0x07;
+    color.blue = b >> 3;
+    return color;
+  }
+
+  // lv_color_t::full
+  inline uint16_t Full(Color color) {
+    uint16_t full;
+    std::memcpy(&full, &color, sizeof(full));
+    return full;
+  }
+
+  inline Color FromFull(uint16_t full) {
+    Color color;
+    std::memcpy(&color, &full, sizeof(color));
+    return color;
+  }
+
+  // lv_color_mix(), with LV_MATH_UDIV255() and LV_COLOR_MIX_ROUND_OFS (128)
+  inline Color Mix(Color c1, Color c2, uint8_t mix) {
+    auto udiv255 = [](uint32_t x) {
+      return (x * 0x8081U) >> 0x17U;
+    };
+    const uint32_t g1 = (c1.greenHigh << 3U) | c1.greenLow;
+    const uint32_t g2 = (c2.greenHigh << 3U) | c2.greenLow;
+    const uint32_t g = udiv255(g1 * mix + g2 * (255U - mix) + 128U);
+    Color ret {};
+    ret.red = udiv255(static_cast<uint32_t>(c1.red) * mix + c2.red * (255U - mix) + 128U);
+    ret.greenHigh = g >> 3U;
+    ret.greenLow = g & 0x07U;
+    ret.blue = udiv255(static_cast<uint32_t>(c1.blue) * mix + c2.blue * (255U - mix) + 128U);
+    return ret;
+  }
+}
@@ -0,0 +1,62 @@
+// Host build of the decoder of the compressed DFU images, used by tools/dfu_compress.py --self-test.
+// Reads a compressed image on stdin and writes the decompressed image on stdout. The data is given to the decoder in
+// parts of 1 to 20 bytes (the size of a DFU packet), so that compressed items are split between parts.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "utility/Lzss.h"
+
+using Pinetime::Utility::LzssDecoder;
+
+namespace {
+  struct Output {
+    uint8_t window[LzssDecoder::windowSize];
+    std::vector<uint8_t> data;
+    uint32_t size;
+  };
+
+  bool OnDecodedByte(void* context, uint8_t value) {
+    auto* output = static_cast<Output*>(context);
+    if (output->data.size() == output->size) {
+      return false;
+    }
+    output->window[output->data.size() % LzssDecoder::windowSize] = value;
+    output->data.push_back(value);
+    return true;
+  }
+}
+
+int main() {
+  std::vector<uint8_t> input {std::istreambuf_iterator<char>(std::cin), std::istreambuf_iterator<char>()};
+  // Header: magic, size, CRC, version, window bits (checked by the Python side)
+  constexpr size_t headerSize = 12;
+  if (input.size() < headerSize) {
+    std::fprintf(stderr, "truncated header\n");
+    return 1;
+  }
+
+  Output output {};
+  std::memcpy(&output.size, input.data() + 4, sizeof(uint32_t));
+  LzssDecoder decoder {output.window, OnDecodedByte, &output};
+  decoder.Reset();
+
+  size_t partSize = 1;
+  for (size_t offset = headerSize; offset < input.size(); offset += partSize, partSize = partSize % 20 + 1) {
+    size_t size = std::min(partSize, input.size() - offset);
+    if (!decoder.Decode(input.data() + offset, size)) {
+      std::fprintf(stderr, "invalid data at offset %zu\n", offset);
+      return 1;
+    }
+  }
+  if (output.data.size() != output.size) {
+    std::fprintf(stderr, "decompressed %zu bytes instead of %u\n", output.data.size(), static_cast<unsigned>(output.size));
+    return 1;
+  }
+  std::fwrite(output.data.data(), 1, output.data.size(), stdout);
+  return 0;
+}
@@ -0,0 +1,40 @@
+# Builds the host programs of tools/host/ for the self-tests of the tools. These programs are built with code of the
+# firmware, so that the self-tests check the firmware itself, not only the Python implementation.
+#
+# The C++ compiler is taken from CXX (default: c++). When it is not found, the host checks are skipped, unless CXX or
+# CI is set: a CI job, or a developer who chose a compiler, expects them to run, a missing compiler is an error then.
+
+import os
+import shutil
+import subprocess
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+
+def find_compiler():
+    """Path of the C++ compiler, or None if the host checks can be skipped"""
+    name = os.environ.get("CXX", "c++")
+    compiler = shutil.which(name)
+    if compiler is None and ("CXX" in os.environ or os.environ.get("CI")):
+        raise RuntimeError("C++ compiler '{}' not found, it is required to run the host checks".format(name))
+    return compiler
+
+
+def build(directory, name, sources, flags=()):
+    """Builds tools/host/<name>.cpp with the given files of src/, returns the path of the executable, or None (after
+    printing a message) if there is no C++ compiler"""
+    compiler = find_compiler()
+    if compiler is None:
+        print("No C++ compiler found, tools/host/{}.cpp is not tested (set CXX to choose one)".format(name))
+        return None
+    executable = os.path.join(directory, name)
+    subprocess.run([compiler, "-std=c++20", "-Wall", "-Wextra", "-Werror", *flags, "-I", os.path.join(ROOT, "src"),
+                    os.path.join(ROOT, "tools", "host", name + ".cpp"), *(os.path.join(ROOT, "src", source) for source in sources),
+                    "-o", executable], check=True)
+    return executable
+
+
+def run(executable, data=b"", check=True):
+    """Runs a host program with data on stdin, returns the completed process (output in stdout)"""
+    return subprocess.run([executable], input=data, stdout=subprocess.PIPE, stderr=None if check else subprocess.DEVNULL,
+                          check=check)
@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+
+# Builds and runs the host checks of firmware code that has no tool of its own: each program of tools/host/ listed
+# below compares the firmware code to a reference implementation, exits with an error on a mismatch, then times the
+# firmware code. The timings are measured on the host (see doc/PerformanceMeasurements.md). The programs are built
+# with tools/host_build.py.
+
+import argparse
+import os
+import sys
+import tempfile
+
+import host_build
+
+# Name of the program in tools/host/: files of src/ it is built with, and the compiler flags of each build
+CHECKS = {
+    "color_packing": (["utility/ColorPacking.cpp"], [[]]),
+    # Both paths of ColorBlending.cpp, the DSP one with tools/host/cmsis/nrf.h
+    "color_blending": (["utility/ColorBlending.cpp"],
+                       [["-DCOLOR_BLENDING_USE_DSP=0"],
+                        ["-DCOLOR_BLENDING_USE_DSP=1", "-I", os.path.join(host_build.ROOT, "tools", "host", "cmsis")]]),
+}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check firmware code against reference implementations on the host")
+    parser.add_argument("checks", nargs="*", help="checks to run: {} (default: all)".format(", ".join(CHECKS)))
+    args = parser.parse_args()
+    for name in args.checks:
+        if name not in CHECKS:
+            parser.error("unknown check: " + name)
+
+    with tempfile.TemporaryDirectory() as directory:
+        for name in args.checks or CHECKS:
+            sources, builds = CHECKS[name]
+            for flags in builds:
+                executable = host_build.build(directory, name, sources, flags=["-O2", *flags])
+                if executable is not None:
+                    sys.stdout.write(host_build.run(executable).stdout.decode())
+
+
+if __name__ == "__main__":
+    sys.exit(main())